@@ -0,0 +1,294 @@
+#include "clifford.h"
+#include "binary_linear_algebra.h"
+#include "bit_kernels.h"
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+
+
+	/// Multiply the Pauli i^q X^x Z^z by the Pauli i^q2 X^x2 Z^z2 from the right.
+	void multiply_row(word_type* x, word_type* z, BinaryPhase& q,
+					  const word_type* x2, const word_type* z2, BinaryPhase q2, size_t words) {
+		size_t anticommuting{};
+		if (words >= bit_kernels::min_words) {
+			anticommuting = bit_kernels::and_popcount(z, x2, words);
+			bit_kernels::xor_into(x, x2, words);
+			bit_kernels::xor_into(z, z2, words);
+		}
+		else {
+			for (size_t w = 0; w < words; ++w) {
+				anticommuting += std::popcount(z[w] & x2[w]);
+				x[w] ^= x2[w];
+				z[w] ^= z2[w];
+			}
+		}
+		q += q2 + 2 * static_cast<int>(anticommuting & 1);
+	}
+
+	/// Phase exponent of the Hermitian Pauli (-1)^sign X^x Z^z, i.e. i^(number of Y's).
+	BinaryPhase hermitian_phase(const word_type* x, const word_type* z, size_t words, bool sign) {
+		size_t y_count{};
+		for (size_t w = 0; w < words; ++w) y_count += std::popcount(x[w] & z[w]);
+		return BinaryPhase{ static_cast<int>(y_count) + 2 * sign };
+	}
+
+	void copy_block(BitMatrix& target, size_t row, size_t col, const BitMatrix& block) {
+		for (size_t i = 0; i < block.rows(); ++i) {
+			for (size_t j = 0; j < block.cols(); ++j) {
+				if (block.get(i, j)) target.set(row + i, col + j);
+			}
+		}
+	}
+
+	BitMatrix columns(const BitMatrix& mat, size_t first, size_t count) {
+		BitMatrix result(mat.rows(), count);
+		for (size_t i = 0; i < mat.rows(); ++i) {
+			for (size_t j = 0; j < count; ++j) {
+				if (mat.get(i, first + j)) result.set(i, j);
+			}
+		}
+		return result;
+	}
+
+	/// Fill the strict lower triangle with random bits, mirrored to the upper triangle if symmetric.
+	void fill_lower_triangle(BitMatrix& mat, std::mt19937_64& rng, bool symmetric) {
+		for (size_t i = 1; i < mat.rows(); ++i) {
+			for (size_t j = 0; j < i; j += 64) {
+				const word_type bits = rng();
+				for (size_t k = j; k < std::min(i, j + 64); ++k) {
+					if (!((bits >> (k - j)) & 1)) continue;
+					mat.set(i, k);
+					if (symmetric) mat.set(k, i);
+				}
+			}
+		}
+	}
+
+	/// Sample the Hadamard layer and qubit permutation from the quantum Mallows distribution.
+	void sample_quantum_mallows(int n, std::mt19937_64& rng, std::vector<bool>& hadamard, std::vector<int>& permutation) {
+		std::uniform_real_distribution<double> uniform{ 0., 1. };
+		std::vector<int> remaining(n);
+		std::iota(remaining.begin(), remaining.end(), 0);
+		hadamard.assign(n, false);
+		permutation.assign(n, 0);
+		for (int i = 0; i < n; ++i) {
+			const int m = n - i;
+			const double eps = std::pow(4., -m);
+			const double r = uniform(rng);
+			const int index = -static_cast<int>(std::ceil(std::log2(r + (1 - r) * eps)));
+			hadamard[i] = index < m;
+			const int k = index < m ? index : 2 * m - index - 1;
+			permutation[i] = remaining[k];
+			remaining.erase(remaining.begin() + k);
+		}
+	}
+
+	/// Symplectic matrix of a Hadamard-free layer [[delta, 0], [gamma delta, delta^-T]].
+	BitMatrix hadamard_free_layer(int n, std::mt19937_64& rng) {
+		BitMatrix gamma(n, n);
+		for (int i = 0; i < n; ++i) {
+			if (rng() & 1) gamma.set(i, i);
+		}
+		fill_lower_triangle(gamma, rng, true);
+		BitMatrix delta = BitMatrix::identity(n);
+		fill_lower_triangle(delta, rng, false);
+
+		BitMatrix layer(2 * n, 2 * n);
+		copy_block(layer, 0, 0, delta);
+		copy_block(layer, n, 0, gamma * delta);
+		copy_block(layer, n, n, inverse(delta)->transpose());
+		return layer;
+	}
+
+}
+
+
+qe::Clifford::Clifford(int num_qubits)
+	: num_qubits_(num_qubits), x_(2 * num_qubits, num_qubits), z_(2 * num_qubits, num_qubits), phases_(2 * num_qubits) {
+	for (int j = 0; j < num_qubits; ++j) {
+		x_.set(j, j);
+		z_.set(num_qubits + j, j);
+	}
+}
+
+qe::Clifford::Clifford(BitMatrix x, BitMatrix z, BinaryPhaseVector phases)
+	: num_qubits_(static_cast<int>(x.cols())), x_(std::move(x)), z_(std::move(z)), phases_(std::move(phases)) {
+	assert(x_.rows() == 2 * x_.cols() && z_.rows() == x_.rows() && z_.cols() == x_.cols() && "The tableau needs to have 2n rows and n columns");
+	assert(phases_.size() == x_.rows() && "There needs to be one phase per tableau row");
+}
+
+Clifford qe::Clifford::from_circuit(int num_qubits, const Circuit& circuit) {
+	Clifford clifford{ num_qubits };
+	clifford.append(circuit);
+	return clifford;
+}
+
+Clifford qe::Clifford::random(int num_qubits, std::mt19937_64& rng) {
+	const int n = num_qubits;
+	std::vector<bool> hadamard;
+	std::vector<int> permutation;
+	sample_quantum_mallows(n, rng, hadamard, permutation);
+
+	const auto layer1 = hadamard_free_layer(n, rng);
+	const auto layer2 = hadamard_free_layer(n, rng);
+
+	// Permute the qubits of the second layer and apply the Hadamard layer.
+	BitMatrix middle(2 * n, 2 * n);
+	for (int i = 0; i < n; ++i) {
+		const int destabilizer = hadamard[i] ? n + i : i;
+		const int stabilizer = hadamard[i] ? i : n + i;
+		std::copy(layer2.row(permutation[i]).begin(), layer2.row(permutation[i]).end(), middle.row(destabilizer).begin());
+		std::copy(layer2.row(n + permutation[i]).begin(), layer2.row(n + permutation[i]).end(), middle.row(stabilizer).begin());
+	}
+
+	const auto symplectic = layer1 * middle;
+	auto x = columns(symplectic, 0, n);
+	auto z = columns(symplectic, n, n);
+	BinaryPhaseVector phases(2 * n);
+	for (int i = 0; i < 2 * n; ++i) {
+		phases[i] = hermitian_phase(x.row(i).data(), z.row(i).data(), x.words_per_row(), rng() & 1);
+	}
+	return Clifford{ std::move(x), std::move(z), std::move(phases) };
+}
+
+BitMatrix qe::Clifford::symplectic_matrix() const {
+	BitMatrix result(2 * num_qubits_, 2 * num_qubits_);
+	copy_block(result, 0, 0, x_);
+	copy_block(result, 0, num_qubits_, z_);
+	return result;
+}
+
+bool qe::Clifford::is_valid() const {
+	const size_t n = num_qubits_;
+	const size_t words = x_.words_per_row();
+	for (size_t i = 0; i < 2 * n; ++i) {
+		const bool sign_bit_free = (hermitian_phase(x_.row(i).data(), z_.row(i).data(), words, false).to_int() & 1) == (phases_[i].to_int() & 1);
+		if (!sign_bit_free) return false;
+		for (size_t j = i + 1; j < 2 * n; ++j) {
+			const size_t product = bit_kernels::and_popcount(x_.row(i).data(), z_.row(j).data(), words) +
+				bit_kernels::and_popcount(z_.row(i).data(), x_.row(j).data(), words);
+			if ((product & 1) != (j == i + n)) return false;
+		}
+	}
+	return true;
+}
+
+void qe::Clifford::apply(const Gate& gate) {
+	const int a = gate.qubit;
+	const int b = gate.target;
+	for (size_t i = 0; i < x_.rows(); ++i) {
+		const bool x = x_.get(i, a);
+		const bool z = z_.get(i, a);
+		PhaseReference q = phases_[i];
+		switch (gate.type) {
+			using enum GateType;
+		case I: break;
+		case X: q += 2 * z; break;
+		case Y: q += 2 * (x ^ z); break;
+		case Z: q += 2 * x; break;
+		case H:
+			q += 2 * (x && z);
+			x_.set(i, a, z);
+			z_.set(i, a, x);
+			break;
+		case S: q += x; z_.set(i, a, x ^ z); break;
+		case SDG: q += 3 * x; z_.set(i, a, x ^ z); break;
+		case SX: q += 3 * z; x_.set(i, a, x ^ z); break;
+		case SXDG: q += z; x_.set(i, a, x ^ z); break;
+		case CX:
+			if (x) x_.flip(i, b);
+			if (z_.get(i, b)) z_.flip(i, a);
+			break;
+		case CZ: {
+			const bool xb = x_.get(i, b);
+			q += 2 * (x && xb);
+			if (x) z_.flip(i, b);
+			if (xb) z_.flip(i, a);
+			break;
+		}
+		case SWAP: {
+			const bool xb = x_.get(i, b);
+			const bool zb = z_.get(i, b);
+			x_.set(i, a, xb);
+			z_.set(i, a, zb);
+			x_.set(i, b, x);
+			z_.set(i, b, z);
+			break;
+		}
+		default: assert(false && "Only Clifford gates can be applied to a Clifford");
+		}
+	}
+}
+
+void qe::Clifford::append(const Circuit& circuit) {
+	for (const auto& gate : circuit) apply(gate);
+}
+
+Clifford qe::Clifford::compose(const Clifford& other) const {
+	assert(num_qubits_ == other.num_qubits_ && "Cannot compose Cliffords on different numbers of qubits");
+	const size_t n = num_qubits_;
+	const size_t words = x_.words_per_row();
+	Clifford result{ BitMatrix(2 * n, n), BitMatrix(2 * n, n), phases_ };
+
+	// Row i of this tableau is i^q X^x Z^z, so its image under other is i^q times the
+	// product of the rows of other selected by x (in order) and then by z.
+	for (size_t i = 0; i < 2 * n; ++i) {
+		word_type* x = result.x_.row(i).data();
+		word_type* z = result.z_.row(i).data();
+		BinaryPhase q = phases_[i];
+		for (size_t half = 0; half < 2; ++half) {
+			const auto selection = (half == 0 ? x_ : z_).row(i);
+			for (size_t w = 0; w < words; ++w) {
+				for (word_type bits = selection[w]; bits; bits &= bits - 1) {
+					const size_t k = half * n + w * BitMatrix::word_bits + std::countr_zero(bits);
+					multiply_row(x, z, q, other.x_.row(k).data(), other.z_.row(k).data(), other.phases_[k], words);
+				}
+			}
+		}
+		result.phases_[i] = q;
+	}
+	return result;
+}
+
+Clifford qe::Clifford::inverse() const {
+	// The inverse of a symplectic matrix [[A, B], [C, D]] is [[D^T, B^T], [C^T, A^T]].
+	const size_t n = num_qubits_;
+	const auto xt = x_.transpose();
+	const auto zt = z_.transpose();
+	BitMatrix x(2 * n, n);
+	BitMatrix z(2 * n, n);
+	copy_block(x, 0, 0, columns(zt, n, n));
+	copy_block(x, n, 0, columns(xt, n, n));
+	copy_block(z, 0, 0, columns(zt, 0, n));
+	copy_block(z, n, 0, columns(xt, 0, n));
+
+	BinaryPhaseVector phases(2 * n);
+	for (size_t i = 0; i < 2 * n; ++i) {
+		phases[i] = hermitian_phase(x.row(i).data(), z.row(i).data(), x.words_per_row(), false);
+	}
+	Clifford result{ std::move(x), std::move(z), std::move(phases) };
+
+	// Composing with the candidate leaves a Pauli that flips the signs of some X_j and Z_j.
+	// Applying that Pauli after the candidate fixes its phases.
+	const auto frame = compose(result);
+	BitMatrix x_signs(1, n);
+	BitMatrix z_signs(1, n);
+	for (size_t j = 0; j < n; ++j) {
+		if (frame.phases_[j] == 2) x_signs.set(0, j);
+		if (frame.phases_[n + j] == 2) z_signs.set(0, j);
+	}
+	for (size_t i = 0; i < 2 * n; ++i) {
+		size_t flips{};
+		for (size_t w = 0; w < result.x_.words_per_row(); ++w) {
+			flips += std::popcount(result.x_.row(i)[w] & x_signs.row(0)[w]) + std::popcount(result.z_.row(i)[w] & z_signs.row(0)[w]);
+		}
+		result.phases_[i] += 2 * static_cast<int>(flips & 1);
+	}
+	return result;
+}
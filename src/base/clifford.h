@@ -0,0 +1,77 @@
+#pragma once
+
+#include "circuit.h"
+#include "bit_matrix.h"
+#include "binary_phase_vector.h"
+#include <random>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Clifford operator stored as a stabilizer tableau over F2.
+	///
+	/// Row j < n is the image C X_j C^dagger of the Pauli X on qubit j (destabilizer) and row
+	/// n + j the image of Z_j (stabilizer). Each row is a Pauli i^q X^x Z^z with bit vectors
+	/// x and z of length n and a phase exponent q, where X^x Z^z is the tensor product of
+	/// X_k^(x_k) Z_k^(z_k). In this form, Y = i X Z and multiplying two rows only needs the
+	/// parity of z1 & x2 to update the phase. The global phase of the operator is not tracked.
+	class Clifford {
+	public:
+		/// @brief Create the identity on num_qubits qubits.
+		explicit Clifford(int num_qubits);
+
+		/// @brief Create a Clifford from the images of the X and Z operators (see class description).
+		/// @param x Bit matrix with 2n rows and n columns.
+		/// @param z Bit matrix with 2n rows and n columns.
+		/// @param phases Phase exponents of the 2n rows.
+		Clifford(BitMatrix x, BitMatrix z, BinaryPhaseVector phases);
+
+		static Clifford identity(int num_qubits) { return Clifford{ num_qubits }; }
+
+		/// @brief Create the Clifford implemented by a circuit of Clifford gates.
+		static Clifford from_circuit(int num_qubits, const Circuit& circuit);
+
+		/// @brief Sample a Clifford uniformly at random (up to global phase) using the
+		///    O(n^3/64) algorithm of Bravyi and Maslov, "Hadamard-free circuits expose the
+		///    structure of the Clifford group" (2021).
+		static Clifford random(int num_qubits, std::mt19937_64& rng);
+
+
+		int num_qubits() const { return num_qubits_; }
+
+		const BitMatrix& x() const { return x_; }
+		const BitMatrix& z() const { return z_; }
+		const BinaryPhaseVector& phases() const { return phases_; }
+
+		/// @brief The symplectic matrix [x | z] with 2n rows and 2n columns.
+		BitMatrix symplectic_matrix() const;
+
+		/// @brief Check that the tableau is symplectic and each row is a Hermitian Pauli.
+		bool is_valid() const;
+
+
+		/// @brief Apply a Clifford gate after this Clifford.
+		void apply(const Gate& gate);
+
+		/// @brief Apply all gates of a circuit after this Clifford.
+		void append(const Circuit& circuit);
+
+		/// @brief Returns the Clifford that first applies this Clifford and then the other one.
+		///    Each row of the result is a product of rows of the other tableau, so the cost
+		///    is O(n^3/64).
+		Clifford compose(const Clifford& other) const;
+
+		/// @brief Returns the inverse Clifford.
+		Clifford inverse() const;
+
+		friend bool operator==(const Clifford&, const Clifford&) = default;
+
+	private:
+		int num_qubits_{};
+		BitMatrix x_;
+		BitMatrix z_;
+		BinaryPhaseVector phases_;
+	};
+
+}
@@ -0,0 +1,90 @@
+#include "graph_state.h"
+#include <bit>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+
+	template<class F>
+	void for_each_neighbour(const Graph& graph, int vertex, F&& f) {
+		const auto row = graph.adjacency_matrix.row(vertex);
+		for (size_t w = 0; w < row.size(); ++w) {
+			for (word_type bits = row[w]; bits; bits &= bits - 1) {
+				f(static_cast<int>(w * BitMatrix::word_bits) + std::countr_zero(bits));
+			}
+		}
+	}
+
+	/// Remove all edges of a vertex.
+	void isolate(Graph& graph, int vertex) {
+		for_each_neighbour(graph, vertex, [&](int b) { graph.adjacency_matrix.reset(b, vertex); });
+		for (auto& word : graph.adjacency_matrix.row(vertex)) word = 0;
+	}
+
+}
+
+
+BitMatrix GraphStateStabilizers::to_matrix() const {
+	const int n = num_qubits();
+	BitMatrix matrix(n, 2 * n);
+	for (int v = 0; v < n; ++v) {
+		matrix.set(v, v);
+		for_each_neighbour(*graph, v, [&](int w) { matrix.set(v, n + w); });
+	}
+	return matrix;
+}
+
+
+Circuit qe::measure_pauli(Graph& graph, int vertex, MeasurementBasis basis, bool negative_outcome, int neighbour) {
+	Circuit correction{ graph.num_vertices() };
+	switch (basis) {
+	case MeasurementBasis::Z:
+		if (negative_outcome) for_each_neighbour(graph, vertex, [&](int b) { correction.z(b); });
+		isolate(graph, vertex);
+		break;
+
+	case MeasurementBasis::Y:
+		// sqrt(-iZ) = S and sqrt(iZ) = S^dagger up to global phase
+		for_each_neighbour(graph, vertex, [&](int b) { negative_outcome ? correction.sdg(b) : correction.s(b); });
+		graph.local_complementation(vertex);
+		isolate(graph, vertex);
+		break;
+
+	case MeasurementBasis::X: {
+		if (neighbour < 0) {
+			const int first = static_cast<int>(graph.adjacency_matrix.row_find_first(vertex));
+			if (first == graph.num_vertices()) {
+				assert(!negative_outcome && "Measuring X at an isolated vertex always yields +1");
+				break;
+			}
+			neighbour = first;
+		}
+		assert(graph.has_edge(vertex, neighbour) && "The X measurement needs a neighbour of the measured vertex");
+		const int a = vertex;
+		const int b0 = neighbour;
+		// sqrt(iY) = Z H and sqrt(-iY) = H Z up to global phase
+		if (negative_outcome) {
+			correction.z(b0);
+			correction.h(b0);
+			for_each_neighbour(graph, b0, [&](int b) {
+				if (b != a && !graph.has_edge(a, b)) correction.z(b);
+			});
+		}
+		else {
+			correction.h(b0);
+			correction.z(b0);
+			for_each_neighbour(graph, a, [&](int b) {
+				if (b != b0 && !graph.has_edge(b0, b)) correction.z(b);
+			});
+		}
+		graph.local_complementation(b0);
+		graph.local_complementation(a);
+		isolate(graph, a);
+		graph.local_complementation(b0);
+		break;
+	}
+	}
+	return correction;
+}
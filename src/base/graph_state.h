@@ -0,0 +1,66 @@
+#pragma once
+
+#include "circuit.h"
+#include "graph.h"
+#include <span>
+
+
+namespace qe {
+
+	/// @brief View of the stabilizer generators K_v = X_v Z^(N(v)) of the graph state |G>, i.e.
+	///    the rows of the matrix [I | Γ] with the adjacency matrix Γ.
+	///
+	/// The Z part of each generator is the corresponding row of the adjacency matrix, which is
+	/// handed out directly, so no tableau is built. The view refers to the graph and is
+	/// invalidated when the graph is destroyed.
+	class GraphStateStabilizers {
+	public:
+		using word_type = BitMatrix::word_type;
+
+		explicit GraphStateStabilizers(const Graph& graph) : graph(&graph) {}
+
+		int num_qubits() const { return graph->num_vertices(); }
+
+		/// @brief X exponent of the given qubit in a generator.
+		bool x(int generator, int qubit) const { return generator == qubit; }
+
+		/// @brief Z exponent of the given qubit in a generator.
+		bool z(int generator, int qubit) const { return graph->has_edge(generator, qubit); }
+
+		/// @brief Packed Z part of a generator (a row of the adjacency matrix).
+		std::span<const word_type> z_row(int generator) const { return graph->adjacency_matrix.row(generator); }
+
+		/// @brief The Z block Γ of [I | Γ].
+		const BitMatrix& z_block() const { return graph->adjacency_matrix; }
+
+		/// @brief Copy into an explicit n x 2n matrix [I | Γ].
+		BitMatrix to_matrix() const;
+
+	private:
+		const Graph* graph;
+	};
+
+
+	enum class MeasurementBasis { X, Y, Z };
+
+	/// @brief Measure a vertex of a graph state in a Pauli basis and update the graph in place
+	///    with the rules of Hein, Eisert and Briegel, "Multiparty entanglement in graph states"
+	///    (2004).
+	///
+	/// With outcome ±1, the state becomes |P, ±>_a ⊗ U |G'>, where |P, ±> is the eigenstate
+	/// of the measured Pauli P at vertex a and
+	///  - Z: G' = G - a, U+ = 1, U- = prod_{b in N(a)} Z_b;
+	///  - Y: G' = τ_a(G) - a, U± = prod_{b in N(a)} sqrt(∓iZ_b);
+	///  - X: G' = τ_b0(τ_a(τ_b0(G)) - a) for a neighbour b0 of a,
+	///    U+ = sqrt(+iY_b0) prod_{b in N(a) - N(b0) - {b0}} Z_b and
+	///    U- = sqrt(-iY_b0) prod_{b in N(b0) - N(a) - {a}} Z_b.
+	/// Here τ_v is the local complementation at v and G - a removes all edges of a, which
+	/// becomes an isolated vertex. All rewrites are local complementations and row updates of
+	/// the adjacency matrix, so no stabilizer tableau is involved. A measurement of X at an
+	/// isolated vertex always yields +1 and changes nothing.
+	/// @param negative_outcome True for the outcome -1.
+	/// @param neighbour The neighbour b0 for an X measurement. By default the smallest one.
+	/// @return The local Clifford U (up to global phase) as a circuit on all vertices.
+	Circuit measure_pauli(Graph& graph, int vertex, MeasurementBasis basis, bool negative_outcome, int neighbour = -1);
+
+}
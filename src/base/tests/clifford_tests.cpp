@@ -0,0 +1,96 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "clifford.h"
+#include <map>
+
+using namespace qe;
+
+
+static Circuit random_circuit(int num_qubits, int num_gates, std::mt19937_64& rng) {
+	using enum GateType;
+	constexpr GateType single_qubit_gates[]{ I, X, Y, Z, H, S, SDG, SX, SXDG };
+	constexpr GateType two_qubit_gates[]{ CX, CZ, SWAP };
+	Circuit circuit(num_qubits);
+	for (int g = 0; g < num_gates; ++g) {
+		const int qubit = static_cast<int>(rng() % num_qubits);
+		const int target = static_cast<int>((qubit + 1 + rng() % (num_qubits - 1)) % num_qubits);
+		if (rng() % 3 == 0) circuit.add({ .qubit = qubit, .target = target, .type = two_qubit_gates[rng() % 3] });
+		else circuit.add({ .qubit = qubit, .type = single_qubit_gates[rng() % 9] });
+	}
+	return circuit;
+}
+
+
+TEST_CASE("Clifford identity") {
+	Clifford clifford{ 3 };
+	REQUIRE(clifford.num_qubits() == 3);
+	REQUIRE(clifford.symplectic_matrix() == BitMatrix::identity(6));
+	REQUIRE(clifford.is_valid());
+	REQUIRE(clifford == Clifford::identity(3));
+}
+
+TEST_CASE("Clifford gate relations") {
+	auto from = [](auto build) {
+		Circuit circuit(2);
+		build(circuit);
+		return Clifford::from_circuit(2, circuit);
+	};
+	const auto identity = Clifford::identity(2);
+	REQUIRE(from([](Circuit& c) { c.h(0); c.h(0); }) == identity);
+	REQUIRE(from([](Circuit& c) { c.s(1); c.sdg(1); }) == identity);
+	REQUIRE(from([](Circuit& c) { c.cx(0, 1); c.cx(0, 1); }) == identity);
+	REQUIRE(from([](Circuit& c) { c.s(0); c.s(0); }) == from([](Circuit& c) { c.z(0); }));
+	REQUIRE(from([](Circuit& c) { c.sx(1); c.sx(1); }) == from([](Circuit& c) { c.x(1); }));
+	REQUIRE(from([](Circuit& c) { c.x(0); c.z(0); }) == from([](Circuit& c) { c.y(0); }));
+	REQUIRE(from([](Circuit& c) { c.h(0); c.s(0); c.h(0); }) == from([](Circuit& c) { c.sx(0); }));
+	REQUIRE(from([](Circuit& c) { c.h(1); c.cx(0, 1); c.h(1); }) == from([](Circuit& c) { c.cz(0, 1); }));
+	REQUIRE(from([](Circuit& c) { c.cx(0, 1); c.cx(1, 0); c.cx(0, 1); }) == from([](Circuit& c) { c.swap(0, 1); }));
+	REQUIRE(from([](Circuit& c) { c.h(0); c.s(0); }) != from([](Circuit& c) { c.s(0); c.h(0); }));
+
+	// H maps X to Z, S maps X to Y = iXZ.
+	const auto h = from([](Circuit& c) { c.h(0); });
+	REQUIRE(h.z().get(0, 0));
+	REQUIRE(!h.x().get(0, 0));
+	const auto s = from([](Circuit& c) { c.s(0); });
+	REQUIRE(s.x().get(0, 0));
+	REQUIRE(s.z().get(0, 0));
+	REQUIRE(s.phases()[0] == 1);
+}
+
+TEST_CASE("Clifford compose() and inverse()") {
+	std::mt19937_64 rng{ 1 };
+	for (int n : { 2, 3, 7, 70 }) {
+		const auto c1 = random_circuit(n, 10 * n, rng);
+		const auto c2 = random_circuit(n, 10 * n, rng);
+		const auto a = Clifford::from_circuit(n, c1);
+		const auto b = Clifford::from_circuit(n, c2);
+		REQUIRE(a.is_valid());
+		REQUIRE(a.compose(b) == Clifford::from_circuit(n, c1 + c2));
+		REQUIRE(a.inverse() == Clifford::from_circuit(n, c1.inverse()));
+		REQUIRE(a.compose(a.inverse()) == Clifford::identity(n));
+		REQUIRE(a.inverse().compose(a) == Clifford::identity(n));
+	}
+}
+
+TEST_CASE("Clifford random()") {
+	std::mt19937_64 rng{ 2 };
+	for (int n : { 1, 2, 5, 40, 100 }) {
+		for (int sample = 0; sample < 5; ++sample) {
+			const auto clifford = Clifford::random(n, rng);
+			REQUIRE(clifford.is_valid());
+			REQUIRE(clifford.compose(clifford.inverse()) == Clifford::identity(n));
+		}
+	}
+
+	// All 24 single-qubit Cliffords (up to global phase) occur with equal frequency.
+	std::map<std::tuple<bool, bool, bool, bool, unsigned int, unsigned int>, int> counts;
+	for (int sample = 0; sample < 24000; ++sample) {
+		const auto c = Clifford::random(1, rng);
+		++counts[{ c.x().get(0, 0), c.z().get(0, 0), c.x().get(1, 0), c.z().get(1, 0), c.phases()[0].to_int(), c.phases()[1].to_int() }];
+	}
+	REQUIRE(counts.size() == 24);
+	for (const auto& [clifford, count] : counts) {
+		REQUIRE(count > 800);
+		REQUIRE(count < 1200);
+	}
+}
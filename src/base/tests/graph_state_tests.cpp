@@ -0,0 +1,137 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "graph_state.h"
+#include <cmath>
+#include <complex>
+#include <random>
+
+using namespace qe;
+
+using Amplitude = std::complex<double>;
+using State = std::vector<Amplitude>;
+
+
+/// Amplitudes of |G>, where bit v of the index is qubit v.
+static State graph_state(const Graph& graph) {
+	const int n = graph.num_vertices();
+	State state(size_t{ 1 } << n);
+	for (size_t x = 0; x < state.size(); ++x) {
+		int parity{};
+		for (const auto& [i, j] : graph.get_edges()) parity ^= (x >> i) & (x >> j) & 1;
+		state[x] = (parity ? -1.0 : 1.0) / std::sqrt(static_cast<double>(state.size()));
+	}
+	return state;
+}
+
+static void apply(State& state, GateType type, int qubit) {
+	const size_t bit = size_t{ 1 } << qubit;
+	const Amplitude i{ 0, 1 };
+	for (size_t x = 0; x < state.size(); ++x) {
+		if (x & bit) continue;
+		Amplitude& a0 = state[x];
+		Amplitude& a1 = state[x | bit];
+		switch (type) {
+		case GateType::X: std::swap(a0, a1); break;
+		case GateType::Y: std::tie(a0, a1) = std::pair{ -i * a1, i * a0 }; break;
+		case GateType::Z: a1 = -a1; break;
+		case GateType::H: std::tie(a0, a1) = std::pair{ (a0 + a1) / std::sqrt(2.0), (a0 - a1) / std::sqrt(2.0) }; break;
+		case GateType::S: a1 *= i; break;
+		case GateType::SDG: a1 *= -i; break;
+		default: FAIL("Unsupported gate");
+		}
+	}
+}
+
+/// Project onto the eigenspace of the Pauli at the given qubit.
+static State project(State state, MeasurementBasis basis, int qubit, bool negative) {
+	State image = state;
+	apply(image, basis == MeasurementBasis::X ? GateType::X : basis == MeasurementBasis::Y ? GateType::Y : GateType::Z, qubit);
+	for (size_t x = 0; x < state.size(); ++x) state[x] = (state[x] + (negative ? -1.0 : 1.0) * image[x]) / 2.0;
+	return state;
+}
+
+static double norm(const State& state) {
+	double sum{};
+	for (const auto& a : state) sum += std::norm(a);
+	return std::sqrt(sum);
+}
+
+/// |<a|b>| / (|a| |b|)
+static double fidelity(const State& a, const State& b) {
+	Amplitude overlap{};
+	for (size_t x = 0; x < a.size(); ++x) overlap += std::conj(a[x]) * b[x];
+	return std::abs(overlap) / (norm(a) * norm(b));
+}
+
+
+TEST_CASE("GraphStateStabilizers") {
+	const auto graph = Graph::star(70);
+	const GraphStateStabilizers stabilizers{ graph };
+	REQUIRE(stabilizers.num_qubits() == 70);
+	REQUIRE(stabilizers.x(3, 3));
+	REQUIRE_FALSE(stabilizers.x(3, 0));
+	REQUIRE(stabilizers.z(3, 0));
+	REQUIRE(stabilizers.z_row(0).data() == graph.adjacency_matrix.row(0).data());
+	REQUIRE(&stabilizers.z_block() == &graph.adjacency_matrix);
+
+	const auto matrix = stabilizers.to_matrix();
+	REQUIRE(matrix.rows() == 70);
+	REQUIRE(matrix.cols() == 140);
+	for (int i = 0; i < 70; ++i) {
+		for (int j = 0; j < 70; ++j) {
+			REQUIRE(matrix.get(i, j) == (i == j));
+			REQUIRE(matrix.get(i, 70 + j) == graph.has_edge(i, j));
+		}
+	}
+}
+
+TEST_CASE("measure_pauli() agrees with the state vector") {
+	std::mt19937 rng{ 21 };
+	std::bernoulli_distribution edge{ 0.5 };
+	for (int trial = 0; trial < 12; ++trial) {
+		const int n = 3 + trial % 4;
+		Graph graph{ n };
+		for (int i = 0; i < n; ++i) {
+			for (int j = i + 1; j < n; ++j) {
+				if (edge(rng)) graph.add_edge(i, j);
+			}
+		}
+		const auto state = graph_state(graph);
+
+		for (int a = 0; a < n; ++a) {
+			for (auto basis : { MeasurementBasis::X, MeasurementBasis::Y, MeasurementBasis::Z }) {
+				for (bool negative : { false, true }) {
+					const auto measured = project(state, basis, a, negative);
+					if (norm(measured) < 1e-9) continue;
+
+					std::vector<int> choices{ -1 };
+					if (basis == MeasurementBasis::X) {
+						for (int b = 0; b < n; ++b) {
+							if (graph.has_edge(a, b)) choices.push_back(b);
+						}
+					}
+					for (int b0 : choices) {
+						auto result = graph;
+						const auto correction = measure_pauli(result, a, basis, negative, b0);
+						for (int v = 0; v < n; ++v) REQUIRE_FALSE(result.has_edge(a, v));
+
+						// |P, ±>_a ⊗ U |G'>, where a is in |+> in |G'>
+						auto expected = graph_state(result);
+						for (const auto& gate : correction) {
+							REQUIRE(gate.qubit != a);
+							apply(expected, gate.type, gate.qubit);
+						}
+						expected = project(expected, basis, a, negative);
+						if (basis == MeasurementBasis::X && negative) {
+							// |+> has no overlap with |->; flip qubit a explicitly
+							expected = graph_state(result);
+							apply(expected, GateType::Z, a);
+							for (const auto& gate : correction) apply(expected, gate.type, gate.qubit);
+						}
+						REQUIRE(fidelity(expected, measured) > 1 - 1e-9);
+					}
+				}
+			}
+		}
+	}
+}
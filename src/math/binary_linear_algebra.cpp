@@ -0,0 +1,234 @@
+#include "binary_linear_algebra.h"
+#include <algorithm>
+#include <bit>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+	constexpr size_t word_bits = BitMatrix::word_bits;
+	constexpr size_t max_block_size = 8;
+
+
+	void xor_words(word_type* target, const word_type* source, size_t begin, size_t end) {
+		if (end - begin >= bit_kernels::min_words) {
+			bit_kernels::xor_into(target + begin, source + begin, end - begin);
+			return;
+		}
+		for (size_t k = begin; k < end; ++k) target[k] ^= source[k];
+	}
+
+	/// Plain Gauss-Jordan elimination for matrices with at most 64 columns where each row is a single word.
+	std::vector<size_t> echelonize_single_word(BitMatrix& mat, bool reduced, size_t num_cols) {
+		std::vector<size_t> pivots;
+		word_type* rows = mat.data();
+		size_t r = 0;
+		for (size_t c = 0; c < num_cols && r < mat.rows(); ++c) {
+			const word_type mask = word_type{ 1 } << c;
+			size_t p = r;
+			while (p < mat.rows() && !(rows[p] & mask)) ++p;
+			if (p == mat.rows()) continue;
+			std::swap(rows[p], rows[r]);
+			for (size_t i = reduced ? 0 : r + 1; i < mat.rows(); ++i) {
+				if (i != r && (rows[i] & mask)) rows[i] ^= rows[r];
+			}
+			pivots.push_back(c);
+			++r;
+		}
+		return pivots;
+	}
+
+	/// Rank of a set of single-word rows by insertion into a basis indexed by the lowest set bit.
+	size_t rank_single_word(const word_type* rows, size_t num_rows) {
+		word_type basis[word_bits]{};
+		size_t rank{};
+		for (size_t i = 0; i < num_rows && rank < word_bits; ++i) {
+			word_type x = rows[i];
+			while (x) {
+				const auto b = std::countr_zero(x);
+				if (!basis[b]) {
+					basis[b] = x;
+					++rank;
+					break;
+				}
+				x ^= basis[b];
+			}
+		}
+		return rank;
+	}
+
+	/// Build [a | b] where b starts at the first word boundary after the columns of a.
+	BitMatrix augment(const BitMatrix& a, const BitMatrix& b) {
+		const size_t left_words = a.words_per_row();
+		BitMatrix result(a.rows(), left_words * word_bits + b.cols());
+		for (size_t i = 0; i < a.rows(); ++i) {
+			std::copy(a.row(i).begin(), a.row(i).end(), result.row(i).begin());
+			std::copy(b.row(i).begin(), b.row(i).end(), result.row(i).begin() + left_words);
+		}
+		return result;
+	}
+
+	/// Copy cols columns starting at the word boundary first_word into a new matrix.
+	BitMatrix extract(const BitMatrix& mat, size_t first_word, size_t cols) {
+		BitMatrix result(mat.rows(), cols);
+		for (size_t i = 0; i < mat.rows(); ++i) {
+			const auto source = mat.row(i).subspan(first_word, result.words_per_row());
+			std::copy(source.begin(), source.end(), result.row(i).begin());
+		}
+		return result;
+	}
+
+}
+
+
+std::vector<size_t> qe::echelonize(BitMatrix& mat, bool reduced, size_t num_cols) {
+	num_cols = std::min(num_cols, mat.cols());
+	const size_t rows = mat.rows();
+	const size_t words = mat.words_per_row();
+	if (words == 1) return echelonize_single_word(mat, reduced, num_cols);
+
+	auto row = [&](size_t i) { return mat.data() + i * words; };
+
+	const size_t block_size = std::clamp<size_t>(std::bit_width(rows) * 3 / 4, 1, max_block_size);
+	std::vector<word_type> table((size_t{ 1 } << block_size) * words);
+	auto table_entry = [&](size_t index) { return table.data() + index * words; };
+
+	std::vector<size_t> pivots;
+	size_t r = 0;
+	for (size_t c = 0; c < num_cols && r < rows; c += block_size) {
+		const size_t k = std::min(block_size, num_cols - c);
+		const size_t first_word = c / word_bits;
+		size_t block_pivots[max_block_size];
+		size_t found = 0;
+
+		// Find up to k pivots in the columns [c, c+k). Candidate rows are reduced by the pivots
+		// found so far (only virtually on the block bits until a candidate is selected), and the
+		// pivot rows are kept reduced among each other so they form an identity on the pivot columns.
+		for (size_t cc = 0; cc < k && r + found < rows; ++cc) {
+			for (size_t i = r + found; i < rows; ++i) {
+				word_type bits = mat.read_bits(i, c, k);
+				unsigned int used{};
+				for (size_t t = 0; t < found; ++t) {
+					if ((bits >> block_pivots[t]) & 1) {
+						bits ^= mat.read_bits(r + t, c, k);
+						used |= 1u << t;
+					}
+				}
+				if (!((bits >> cc) & 1)) continue;
+
+				for (size_t t = 0; t < found; ++t) {
+					if ((used >> t) & 1) xor_words(row(i), row(r + t), first_word, words);
+				}
+				mat.swap_rows(i, r + found);
+				for (size_t t = 0; t < found; ++t) {
+					if ((mat.read_bits(r + t, c, k) >> cc) & 1) xor_words(row(r + t), row(r + found), first_word, words);
+				}
+				block_pivots[found++] = cc;
+				break;
+			}
+		}
+		if (found == 0) continue;
+
+		// Table of all 2^found combinations of the pivot rows, each built from a previous entry with one XOR.
+		std::fill(table_entry(0) + first_word, table_entry(0) + words, 0);
+		for (size_t m = 1; m < (size_t{ 1 } << found); ++m) {
+			const word_type* previous = table_entry(m & (m - 1));
+			const word_type* pivot_row = row(r + std::countr_zero(m));
+			word_type* entry = table_entry(m);
+			for (size_t w = first_word; w < words; ++w) entry[w] = previous[w] ^ pivot_row[w];
+		}
+
+		for (size_t i = reduced ? 0 : r + found; i < rows; ++i) {
+			if (i >= r && i < r + found) continue;
+			const word_type bits = mat.read_bits(i, c, k);
+			size_t index{};
+			for (size_t t = 0; t < found; ++t) index |= ((bits >> block_pivots[t]) & 1) << t;
+			if (index) xor_words(row(i), table_entry(index), first_word, words);
+		}
+
+		for (size_t t = 0; t < found; ++t) pivots.push_back(c + block_pivots[t]);
+		r += found;
+	}
+	return pivots;
+}
+
+size_t qe::rank(const BitMatrix& mat) {
+	if (mat.words_per_row() == 1) return rank_single_word(mat.data(), mat.rows());
+	BitMatrix copy{ mat };
+	return echelonize(copy, false).size();
+}
+
+size_t qe::rank(const Matrix<Binary>& mat) {
+	return rank(BitMatrix{ mat });
+}
+
+RowEchelonForm qe::row_reduce(const BitMatrix& mat) {
+	auto augmented = augment(mat, BitMatrix::identity(mat.rows()));
+	auto pivots = echelonize(augmented, true, mat.cols());
+	return RowEchelonForm{
+		.reduced = extract(augmented, 0, mat.cols()),
+		.transformation = extract(augmented, mat.words_per_row(), mat.rows()),
+		.pivot_columns = std::move(pivots)
+	};
+}
+
+RowEchelonForm qe::row_reduce(const Matrix<Binary>& mat) {
+	return row_reduce(BitMatrix{ mat });
+}
+
+std::optional<BitMatrix> qe::inverse(const BitMatrix& mat) {
+	MATRIX_VERIFY(mat.rows() == mat.cols(), "Only square matrices can be inverted", Matrix_shape_error);
+	auto augmented = augment(mat, BitMatrix::identity(mat.rows()));
+	if (echelonize(augmented, true, mat.cols()).size() < mat.rows()) return std::nullopt;
+	return extract(augmented, mat.words_per_row(), mat.rows());
+}
+
+std::optional<Matrix<Binary>> qe::inverse(const Matrix<Binary>& mat) {
+	if (auto result = inverse(BitMatrix{ mat })) return result->to_matrix();
+	return std::nullopt;
+}
+
+std::optional<BitMatrix> qe::solve(const BitMatrix& a, const BitMatrix& b) {
+	MATRIX_VERIFY(a.rows() == b.rows(), "Cannot solve linear system with non-matching dimensions", Matrix_shape_error);
+	auto augmented = augment(a, b);
+	const auto pivots = echelonize(augmented, true, a.cols());
+	const auto reduced_b = extract(augmented, a.words_per_row(), b.cols());
+	for (size_t i = pivots.size(); i < reduced_b.rows(); ++i) {
+		if (reduced_b.row_count(i) != 0) return std::nullopt;
+	}
+	BitMatrix x(a.cols(), b.cols());
+	for (size_t t = 0; t < pivots.size(); ++t) {
+		std::copy(reduced_b.row(t).begin(), reduced_b.row(t).end(), x.row(pivots[t]).begin());
+	}
+	return x;
+}
+
+std::optional<Matrix<Binary>> qe::solve(const Matrix<Binary>& a, const Matrix<Binary>& b) {
+	if (auto result = solve(BitMatrix{ a }, BitMatrix{ b })) return result->to_matrix();
+	return std::nullopt;
+}
+
+BitMatrix qe::nullspace(const BitMatrix& mat) {
+	BitMatrix reduced{ mat };
+	const auto pivots = echelonize(reduced);
+	BitMatrix basis(mat.cols() - pivots.size(), mat.cols());
+	size_t next_pivot{};
+	size_t index{};
+	for (size_t col = 0; col < mat.cols(); ++col) {
+		if (next_pivot < pivots.size() && pivots[next_pivot] == col) {
+			++next_pivot;
+			continue;
+		}
+		basis.set(index, col);
+		for (size_t t = 0; t < pivots.size(); ++t) {
+			if (reduced.get(t, col)) basis.set(index, pivots[t]);
+		}
+		++index;
+	}
+	return basis;
+}
+
+Matrix<Binary> qe::nullspace(const Matrix<Binary>& mat) {
+	return nullspace(BitMatrix{ mat }).to_matrix();
+}
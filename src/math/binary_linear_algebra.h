@@ -0,0 +1,59 @@
+#pragma once
+
+#include "bit_matrix.h"
+#include <optional>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Result of a Gauss-Jordan elimination over F2.
+	struct RowEchelonForm {
+		/// @brief Reduced row echelon form of the input matrix.
+		BitMatrix reduced;
+		/// @brief Invertible matrix T such that T * A = reduced.
+		BitMatrix transformation;
+		/// @brief Column index of the pivot in each of the first rank() rows (the rank profile).
+		std::vector<size_t> pivot_columns;
+
+		size_t rank() const { return pivot_columns.size(); }
+	};
+
+
+	/// @brief Bring a matrix into row echelon form in place using the Method of Four Russians.
+	///    Blocks of up to 8 pivots are found at once, after which every other row is reduced
+	///    with a single XOR from a table of all combinations of the block's pivot rows.
+	/// @param mat Matrix to transform.
+	/// @param reduced If true, the reduced row echelon form is computed (pivots are also
+	///    eliminated from the rows above), otherwise only the rows below are reduced.
+	/// @param num_cols Only the first num_cols columns are used for pivoting, the remaining
+	///    columns are transformed along (e.g. for augmented matrices).
+	/// @return Pivot columns in ascending order. Their count is the rank.
+	std::vector<size_t> echelonize(BitMatrix& mat, bool reduced = true, size_t num_cols = dynamic);
+
+	/// @brief Compute the rank of a matrix over F2.
+	size_t rank(const BitMatrix& mat);
+	size_t rank(const Matrix<Binary>& mat);
+
+	/// @brief Compute the reduced row echelon form of a matrix together with its rank profile
+	///    and the transformation that produces it.
+	RowEchelonForm row_reduce(const BitMatrix& mat);
+	RowEchelonForm row_reduce(const Matrix<Binary>& mat);
+
+	/// @brief Invert a square matrix over F2.
+	/// @return The inverse or std::nullopt if the matrix is singular.
+	std::optional<BitMatrix> inverse(const BitMatrix& mat);
+	std::optional<Matrix<Binary>> inverse(const Matrix<Binary>& mat);
+
+	/// @brief Solve A * X = B for all columns of B at once. Free variables are set to zero.
+	/// @return A particular solution X or std::nullopt if the system is inconsistent for any
+	///    column of B.
+	std::optional<BitMatrix> solve(const BitMatrix& a, const BitMatrix& b);
+	std::optional<Matrix<Binary>> solve(const Matrix<Binary>& a, const Matrix<Binary>& b);
+
+	/// @brief Compute a basis of the nullspace {x : A * x = 0}.
+	/// @return Matrix whose rows are the basis vectors, one for each non-pivot column of A.
+	BitMatrix nullspace(const BitMatrix& mat);
+	Matrix<Binary> nullspace(const Matrix<Binary>& mat);
+
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "binary_phase.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Proxy reference to a single phase in a BinaryPhaseVector.
+	class PhaseReference {
+	public:
+		using word_type = uint64_t;
+
+		constexpr PhaseReference(word_type* word, unsigned int shift) noexcept : word(word), shift(shift) {}
+
+		constexpr PhaseReference& operator=(BinaryPhase value) noexcept {
+			*word = (*word & ~(word_type{ 0b11 } << shift)) | (word_type{ value.to_int() } << shift);
+			return *this;
+		}
+		constexpr PhaseReference& operator=(const PhaseReference& other) noexcept { return *this = BinaryPhase{ other }; }
+
+		constexpr PhaseReference& operator+=(BinaryPhase value) noexcept { return *this = BinaryPhase{ *this } + value; }
+		constexpr PhaseReference& operator-=(BinaryPhase value) noexcept { return *this = BinaryPhase{ *this } - value; }
+
+		explicit(false) constexpr operator BinaryPhase() const noexcept { return BinaryPhase{ static_cast<int>((*word >> shift) & 0b11) }; }
+		constexpr unsigned int to_int() const noexcept { return BinaryPhase{ *this }.to_int(); }
+
+		constexpr friend bool operator==(const PhaseReference& a, const BinaryPhase& b) noexcept { return BinaryPhase{ a } == b; }
+
+	private:
+		word_type* word;
+		unsigned int shift;
+	};
+
+
+	/// @brief Vector of phases i^q packed with 2 bits per phase, i.e. 32 phases per 64-bit word.
+	///
+	/// Phase k is stored in bits 2(k % 32) and 2(k % 32) + 1 of word k / 32. Unused fields in the
+	/// last word are always zero. Addition of two vectors adds the low bits and carries into the
+	/// high bits with a handful of word operations, so 32 phases are added at once and the loops
+	/// are vectorized by the compiler.
+	class BinaryPhaseVector {
+	public:
+		using word_type = uint64_t;
+		using size_type = size_t;
+
+		static constexpr size_type phases_per_word = 32;
+		/// @brief Mask of the low bit of each 2-bit field.
+		static constexpr word_type low_bits = 0x5555'5555'5555'5555;
+
+
+		constexpr BinaryPhaseVector() = default;
+
+		explicit constexpr BinaryPhaseVector(size_type size) : size_(size), data_(words_for(size)) {}
+
+		constexpr BinaryPhaseVector(size_type size, BinaryPhase value) : BinaryPhaseVector(size) { fill(value); }
+
+		constexpr BinaryPhaseVector(std::initializer_list<BinaryPhase> phases) : BinaryPhaseVector(std::span{ phases.begin(), phases.size() }) {}
+
+		/// @brief Pack a range of phases.
+		explicit constexpr BinaryPhaseVector(std::span<const BinaryPhase> phases) : BinaryPhaseVector(phases.size()) {
+			for (size_type i = 0; i < phases.size(); ++i) {
+				data_[i / phases_per_word] |= word_type{ phases[i].to_int() } << shift(i);
+			}
+		}
+
+		/// @brief Unpack into one BinaryPhase per element.
+		constexpr std::vector<BinaryPhase> to_vector() const {
+			std::vector<BinaryPhase> phases(size_);
+			for (size_type i = 0; i < size_; ++i) phases[i] = (*this)[i];
+			return phases;
+		}
+
+
+		constexpr size_type size() const noexcept { return size_; }
+		constexpr bool empty() const noexcept { return size_ == 0; }
+		constexpr size_type num_words() const noexcept { return data_.size(); }
+
+		constexpr word_type* data() noexcept { return data_.data(); }
+		constexpr const word_type* data() const noexcept { return data_.data(); }
+
+		constexpr PhaseReference operator[](size_type i) noexcept { return { &data_[i / phases_per_word], shift(i) }; }
+		constexpr BinaryPhase operator[](size_type i) const noexcept {
+			return BinaryPhase{ static_cast<int>((data_[i / phases_per_word] >> shift(i)) & 0b11) };
+		}
+
+		constexpr void fill(BinaryPhase value) noexcept {
+			std::fill(data_.begin(), data_.end(), low_bits * value.to_int());
+			clear_padding();
+		}
+
+
+		//
+		// Arithmetic (element-wise modulo 4)
+		//
+
+		constexpr BinaryPhaseVector& operator+=(const BinaryPhaseVector& other) noexcept {
+			assert(size_ == other.size_ && "Cannot add phase vectors of different sizes");
+			for (size_type w = 0; w < data_.size(); ++w) data_[w] = add(data_[w], other.data_[w]);
+			return *this;
+		}
+
+		constexpr BinaryPhaseVector& operator-=(const BinaryPhaseVector& other) noexcept {
+			assert(size_ == other.size_ && "Cannot subtract phase vectors of different sizes");
+			for (size_type w = 0; w < data_.size(); ++w) data_[w] = add(data_[w], negate(other.data_[w]));
+			return *this;
+		}
+
+		/// @brief Add the same phase to every element.
+		constexpr BinaryPhaseVector& operator+=(BinaryPhase value) noexcept {
+			const word_type summand = low_bits * value.to_int();
+			for (auto& word : data_) word = add(word, summand);
+			clear_padding();
+			return *this;
+		}
+
+		constexpr BinaryPhaseVector& operator-=(BinaryPhase value) noexcept { return *this += BinaryPhase{ 0 } - value; }
+
+		/// @brief Replace every phase q by -q.
+		constexpr BinaryPhaseVector& negate() noexcept {
+			for (auto& word : data_) word = negate(word);
+			return *this;
+		}
+
+		/// @brief Add i^2 = -1 to all phases whose bit is set in the given bit vector with
+		///    one bit per phase (e.g. a sign column).
+		constexpr BinaryPhaseVector& add_minus(std::span<const word_type> bits) noexcept {
+			for (size_type w = 0; w < data_.size(); ++w) {
+				const word_type half = (bits[w / 2] >> (w % 2 * phases_per_word)) & 0xFFFF'FFFF;
+				data_[w] ^= spread(half) << 1;
+			}
+			// Bits beyond size() may be set in the input.
+			clear_padding();
+			return *this;
+		}
+
+		constexpr friend BinaryPhaseVector operator+(BinaryPhaseVector a, const BinaryPhaseVector& b) { return a += b; }
+		constexpr friend BinaryPhaseVector operator-(BinaryPhaseVector a, const BinaryPhaseVector& b) { return a -= b; }
+		constexpr friend BinaryPhaseVector operator-(BinaryPhaseVector a) { return a.negate(); }
+
+		constexpr friend bool operator==(const BinaryPhaseVector&, const BinaryPhaseVector&) = default;
+
+
+		/// @brief Add two words of packed phases element-wise modulo 4.
+		static constexpr word_type add(word_type a, word_type b) noexcept {
+			return (a ^ b) ^ ((a & b & low_bits) << 1);
+		}
+
+		/// @brief Negate a word of packed phases element-wise modulo 4.
+		static constexpr word_type negate(word_type a) noexcept {
+			return a ^ ((a & low_bits) << 1);
+		}
+
+		/// @brief Move bit k of the lower 32 bits to bit 2k.
+		static constexpr word_type spread(word_type x) noexcept {
+			x = (x | (x << 16)) & 0x0000'FFFF'0000'FFFF;
+			x = (x | (x << 8)) & 0x00FF'00FF'00FF'00FF;
+			x = (x | (x << 4)) & 0x0F0F'0F0F'0F0F'0F0F;
+			x = (x | (x << 2)) & 0x3333'3333'3333'3333;
+			x = (x | (x << 1)) & 0x5555'5555'5555'5555;
+			return x;
+		}
+
+		static constexpr size_type words_for(size_type size) noexcept { return (size + phases_per_word - 1) / phases_per_word; }
+
+	private:
+		size_type size_{};
+		std::vector<word_type> data_;
+
+		static constexpr unsigned int shift(size_type i) noexcept { return static_cast<unsigned int>(2 * (i % phases_per_word)); }
+
+		constexpr void clear_padding() noexcept {
+			if (size_ % phases_per_word == 0) return;
+			data_.back() &= (word_type{ 1 } << shift(size_)) - 1;
+		}
+	};
+
+}
@@ -0,0 +1,485 @@
+#include "bit_kernels.h"
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define QE_BIT_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define QE_TARGET(features) __attribute__((target(features)))
+#else
+#define QE_TARGET(features)
+#endif
+
+using namespace qe;
+using bit_kernels::word_type;
+
+namespace {
+
+	struct KernelTable {
+		std::string_view name;
+		void (*xor_into)(word_type*, const word_type*, size_t);
+		void (*xor_and_into)(word_type*, const word_type*, const word_type*, size_t);
+		size_t (*popcount)(const word_type*, size_t);
+		size_t (*and_popcount)(const word_type*, const word_type*, size_t);
+		bool (*parity)(const word_type*, size_t);
+		size_t (*find_first_set)(const word_type*, size_t);
+	};
+
+
+	//
+	// Scalar implementation
+	//
+
+	void xor_into_scalar(word_type* target, const word_type* source, size_t n) {
+		for (size_t k = 0; k < n; ++k) target[k] ^= source[k];
+	}
+
+	void xor_and_into_scalar(word_type* target, const word_type* a, const word_type* b, size_t n) {
+		for (size_t k = 0; k < n; ++k) target[k] ^= a[k] & b[k];
+	}
+
+	size_t popcount_scalar(const word_type* a, size_t n) {
+		size_t count{};
+		for (size_t k = 0; k < n; ++k) count += std::popcount(a[k]);
+		return count;
+	}
+
+	size_t and_popcount_scalar(const word_type* a, const word_type* b, size_t n) {
+		size_t count{};
+		for (size_t k = 0; k < n; ++k) count += std::popcount(a[k] & b[k]);
+		return count;
+	}
+
+	bool parity_scalar(const word_type* a, size_t n) {
+		word_type x{};
+		for (size_t k = 0; k < n; ++k) x ^= a[k];
+		return std::popcount(x) & 1;
+	}
+
+	size_t find_first_set_scalar(const word_type* a, size_t n) {
+		for (size_t k = 0; k < n; ++k) {
+			if (a[k]) return k * 64 + std::countr_zero(a[k]);
+		}
+		return n * 64;
+	}
+
+	constexpr KernelTable scalar_kernels{
+		"scalar", xor_into_scalar, xor_and_into_scalar, popcount_scalar, and_popcount_scalar, parity_scalar, find_first_set_scalar
+	};
+
+
+#ifdef QE_BIT_KERNELS_X86
+
+	//
+	// SSE4.2 + POPCNT
+	//
+
+	QE_TARGET("sse4.2,popcnt")
+	void xor_into_sse42(word_type* target, const word_type* source, size_t n) {
+		size_t k = 0;
+		for (; k + 2 <= n; k += 2) {
+			const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + k));
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + k));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + k), _mm_xor_si128(t, s));
+		}
+		for (; k < n; ++k) target[k] ^= source[k];
+	}
+
+	QE_TARGET("sse4.2,popcnt")
+	void xor_and_into_sse42(word_type* target, const word_type* a, const word_type* b, size_t n) {
+		size_t k = 0;
+		for (; k + 2 <= n; k += 2) {
+			const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + k));
+			const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k));
+			const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + k), _mm_xor_si128(t, _mm_and_si128(va, vb)));
+		}
+		for (; k < n; ++k) target[k] ^= a[k] & b[k];
+	}
+
+	QE_TARGET("sse4.2,popcnt")
+	size_t popcount_sse42(const word_type* a, size_t n) {
+		size_t count{};
+		for (size_t k = 0; k < n; ++k) count += _mm_popcnt_u64(a[k]);
+		return count;
+	}
+
+	QE_TARGET("sse4.2,popcnt")
+	size_t and_popcount_sse42(const word_type* a, const word_type* b, size_t n) {
+		size_t count{};
+		for (size_t k = 0; k < n; ++k) count += _mm_popcnt_u64(a[k] & b[k]);
+		return count;
+	}
+
+	QE_TARGET("sse4.2,popcnt")
+	bool parity_sse42(const word_type* a, size_t n) {
+		word_type x{};
+		for (size_t k = 0; k < n; ++k) x ^= a[k];
+		return _mm_popcnt_u64(x) & 1;
+	}
+
+	QE_TARGET("sse4.2,popcnt")
+	size_t find_first_set_sse42(const word_type* a, size_t n) {
+		size_t k = 0;
+		for (; k + 2 <= n; k += 2) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k));
+			if (!_mm_testz_si128(v, v)) break;
+		}
+		for (; k < n; ++k) {
+			if (a[k]) return k * 64 + std::countr_zero(a[k]);
+		}
+		return n * 64;
+	}
+
+	const KernelTable sse42_kernels{
+		"sse4.2", xor_into_sse42, xor_and_into_sse42, popcount_sse42, and_popcount_sse42, parity_sse42, find_first_set_sse42
+	};
+
+
+	//
+	// AVX2 (popcount via nibble lookup table and vpshufb, see Mula, Kurz, Lemire)
+	//
+
+	QE_TARGET("avx2,popcnt")
+	void xor_into_avx2(word_type* target, const word_type* source, size_t n) {
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + k));
+			const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + k));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + k), _mm256_xor_si256(t, s));
+		}
+		for (; k < n; ++k) target[k] ^= source[k];
+	}
+
+	QE_TARGET("avx2,popcnt")
+	void xor_and_into_avx2(word_type* target, const word_type* a, const word_type* b, size_t n) {
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + k));
+			const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+			const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + k), _mm256_xor_si256(t, _mm256_and_si256(va, vb)));
+		}
+		for (; k < n; ++k) target[k] ^= a[k] & b[k];
+	}
+
+	QE_TARGET("avx2,popcnt")
+	inline __m256i popcount_bytes_avx2(__m256i v) {
+		const __m256i lookup = _mm256_setr_epi8(
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low_mask = _mm256_set1_epi8(0x0f);
+		const __m256i lo = _mm256_and_si256(v, low_mask);
+		const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+		return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+	}
+
+	QE_TARGET("avx2,popcnt")
+	inline size_t horizontal_sum_avx2(__m256i v) {
+		return static_cast<size_t>(_mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1) +
+								   _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3));
+	}
+
+	QE_TARGET("avx2,popcnt")
+	size_t popcount_avx2(const word_type* a, size_t n) {
+		__m256i sum = _mm256_setzero_si256();
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+			sum = _mm256_add_epi64(sum, _mm256_sad_epu8(popcount_bytes_avx2(v), _mm256_setzero_si256()));
+		}
+		size_t count = horizontal_sum_avx2(sum);
+		for (; k < n; ++k) count += _mm_popcnt_u64(a[k]);
+		return count;
+	}
+
+	QE_TARGET("avx2,popcnt")
+	size_t and_popcount_avx2(const word_type* a, const word_type* b, size_t n) {
+		__m256i sum = _mm256_setzero_si256();
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+			const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+			const __m256i v = _mm256_and_si256(va, vb);
+			sum = _mm256_add_epi64(sum, _mm256_sad_epu8(popcount_bytes_avx2(v), _mm256_setzero_si256()));
+		}
+		size_t count = horizontal_sum_avx2(sum);
+		for (; k < n; ++k) count += _mm_popcnt_u64(a[k] & b[k]);
+		return count;
+	}
+
+	QE_TARGET("avx2,popcnt")
+	bool parity_avx2(const word_type* a, size_t n) {
+		__m256i acc = _mm256_setzero_si256();
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k)));
+		}
+		word_type x = _mm256_extract_epi64(acc, 0) ^ _mm256_extract_epi64(acc, 1) ^
+					  _mm256_extract_epi64(acc, 2) ^ _mm256_extract_epi64(acc, 3);
+		for (; k < n; ++k) x ^= a[k];
+		return _mm_popcnt_u64(x) & 1;
+	}
+
+	QE_TARGET("avx2,popcnt")
+	size_t find_first_set_avx2(const word_type* a, size_t n) {
+		size_t k = 0;
+		for (; k + 4 <= n; k += 4) {
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+			if (!_mm256_testz_si256(v, v)) break;
+		}
+		for (; k < n; ++k) {
+			if (a[k]) return k * 64 + std::countr_zero(a[k]);
+		}
+		return n * 64;
+	}
+
+	const KernelTable avx2_kernels{
+		"avx2", xor_into_avx2, xor_and_into_avx2, popcount_avx2, and_popcount_avx2, parity_avx2, find_first_set_avx2
+	};
+
+
+	//
+	// AVX-512 (F + VPOPCNTDQ)
+	//
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	void xor_into_avx512(word_type* target, const word_type* source, size_t n) {
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			const __m512i t = _mm512_loadu_si512(target + k);
+			const __m512i s = _mm512_loadu_si512(source + k);
+			_mm512_storeu_si512(target + k, _mm512_xor_si512(t, s));
+		}
+		if (k < n) {
+			const __mmask8 mask = static_cast<__mmask8>((1u << (n - k)) - 1);
+			const __m512i t = _mm512_maskz_loadu_epi64(mask, target + k);
+			const __m512i s = _mm512_maskz_loadu_epi64(mask, source + k);
+			_mm512_mask_storeu_epi64(target + k, mask, _mm512_xor_si512(t, s));
+		}
+	}
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	void xor_and_into_avx512(word_type* target, const word_type* a, const word_type* b, size_t n) {
+		// 0x78 is the truth table of t ^ (a & b) for the operand order (t, a, b).
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			const __m512i t = _mm512_loadu_si512(target + k);
+			const __m512i result = _mm512_ternarylogic_epi64(t, _mm512_loadu_si512(a + k), _mm512_loadu_si512(b + k), 0x78);
+			_mm512_storeu_si512(target + k, result);
+		}
+		if (k < n) {
+			const __mmask8 mask = static_cast<__mmask8>((1u << (n - k)) - 1);
+			const __m512i t = _mm512_maskz_loadu_epi64(mask, target + k);
+			const __m512i va = _mm512_maskz_loadu_epi64(mask, a + k);
+			const __m512i vb = _mm512_maskz_loadu_epi64(mask, b + k);
+			_mm512_mask_storeu_epi64(target + k, mask, _mm512_ternarylogic_epi64(t, va, vb, 0x78));
+		}
+	}
+
+	/// Horizontal sum of the lanes. GCC 12 reports a false -Wuninitialized warning inside
+	/// _mm512_reduce_add_epi64, so the lanes are summed after storing them.
+	QE_TARGET("avx512f")
+	uint64_t reduce_add_avx512(__m512i v) {
+		alignas(64) uint64_t lanes[8];
+		_mm512_store_si512(lanes, v);
+		uint64_t sum{};
+		for (const uint64_t lane : lanes) sum += lane;
+		return sum;
+	}
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	size_t popcount_avx512(const word_type* a, size_t n) {
+		__m512i sum = _mm512_setzero_si512();
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(a + k)));
+		}
+		if (k < n) {
+			const __mmask8 mask = static_cast<__mmask8>((1u << (n - k)) - 1);
+			sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, a + k)));
+		}
+		return static_cast<size_t>(reduce_add_avx512(sum));
+	}
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	size_t and_popcount_avx512(const word_type* a, const word_type* b, size_t n) {
+		__m512i sum = _mm512_setzero_si512();
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			const __m512i v = _mm512_and_si512(_mm512_loadu_si512(a + k), _mm512_loadu_si512(b + k));
+			sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(v));
+		}
+		if (k < n) {
+			const __mmask8 mask = static_cast<__mmask8>((1u << (n - k)) - 1);
+			const __m512i v = _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, a + k), _mm512_maskz_loadu_epi64(mask, b + k));
+			sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(v));
+		}
+		return static_cast<size_t>(reduce_add_avx512(sum));
+	}
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	bool parity_avx512(const word_type* a, size_t n) {
+		__m512i acc = _mm512_setzero_si512();
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			acc = _mm512_xor_si512(acc, _mm512_loadu_si512(a + k));
+		}
+		if (k < n) {
+			const __mmask8 mask = static_cast<__mmask8>((1u << (n - k)) - 1);
+			acc = _mm512_xor_si512(acc, _mm512_maskz_loadu_epi64(mask, a + k));
+		}
+		return reduce_add_avx512(_mm512_popcnt_epi64(acc)) & 1;
+	}
+
+	QE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+	size_t find_first_set_avx512(const word_type* a, size_t n) {
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8) {
+			const __mmask8 nonzero = _mm512_test_epi64_mask(_mm512_loadu_si512(a + k), _mm512_loadu_si512(a + k));
+			if (nonzero) {
+				const size_t w = k + std::countr_zero(static_cast<unsigned int>(nonzero));
+				return w * 64 + std::countr_zero(a[w]);
+			}
+		}
+		for (; k < n; ++k) {
+			if (a[k]) return k * 64 + std::countr_zero(a[k]);
+		}
+		return n * 64;
+	}
+
+	const KernelTable avx512_kernels{
+		"avx512", xor_into_avx512, xor_and_into_avx512, popcount_avx512, and_popcount_avx512, parity_avx512, find_first_set_avx512
+	};
+
+
+	//
+	// CPU feature detection
+	//
+
+	struct CpuFeatures {
+		bool sse42{};
+		bool popcnt{};
+		bool avx2{};
+		bool avx512f{};
+		bool avx512vpopcntdq{};
+	};
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	CpuFeatures detect_cpu_features() {
+		CpuFeatures features;
+		int info[4]{};
+		__cpuid(info, 0);
+		const int max_leaf = info[0];
+		__cpuid(info, 1);
+		features.sse42 = (info[2] >> 20) & 1;
+		features.popcnt = (info[2] >> 23) & 1;
+		const bool osxsave = (info[2] >> 27) & 1;
+		const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+		const bool os_avx = (xcr0 & 0x6) == 0x6;
+		const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+		if (max_leaf >= 7) {
+			__cpuidex(info, 7, 0);
+			features.avx2 = os_avx && ((info[1] >> 5) & 1);
+			features.avx512f = os_avx512 && ((info[1] >> 16) & 1);
+			features.avx512vpopcntdq = os_avx512 && ((info[2] >> 14) & 1);
+		}
+		return features;
+	}
+#else
+	CpuFeatures detect_cpu_features() {
+		__builtin_cpu_init();
+		return CpuFeatures{
+			.sse42 = __builtin_cpu_supports("sse4.2") != 0,
+			.popcnt = __builtin_cpu_supports("popcnt") != 0,
+			.avx2 = __builtin_cpu_supports("avx2") != 0,
+			.avx512f = __builtin_cpu_supports("avx512f") != 0,
+			.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq") != 0,
+		};
+	}
+#endif
+
+	std::vector<const KernelTable*> supported_tables() {
+		std::vector<const KernelTable*> tables{ &scalar_kernels };
+		const auto features = detect_cpu_features();
+		if (features.sse42 && features.popcnt) tables.push_back(&sse42_kernels);
+		if (features.avx2 && features.popcnt) tables.push_back(&avx2_kernels);
+		if (features.avx512f && features.avx512vpopcntdq && features.popcnt) tables.push_back(&avx512_kernels);
+		return tables;
+	}
+
+#else
+
+	std::vector<const KernelTable*> supported_tables() {
+		return { &scalar_kernels };
+	}
+
+#endif
+
+
+	const std::vector<const KernelTable*>& available_tables() {
+		static const std::vector<const KernelTable*> tables = supported_tables();
+		return tables;
+	}
+
+	std::atomic<const KernelTable*>& active_table() {
+		static std::atomic<const KernelTable*> table{ available_tables().back() };
+		return table;
+	}
+
+	const KernelTable& kernels() {
+		return *active_table().load(std::memory_order_relaxed);
+	}
+
+}
+
+
+void qe::bit_kernels::xor_into(word_type* target, const word_type* source, size_t num_words) {
+	kernels().xor_into(target, source, num_words);
+}
+
+void qe::bit_kernels::xor_and_into(word_type* target, const word_type* a, const word_type* b, size_t num_words) {
+	kernels().xor_and_into(target, a, b, num_words);
+}
+
+size_t qe::bit_kernels::popcount(const word_type* a, size_t num_words) {
+	return kernels().popcount(a, num_words);
+}
+
+size_t qe::bit_kernels::and_popcount(const word_type* a, const word_type* b, size_t num_words) {
+	return kernels().and_popcount(a, b, num_words);
+}
+
+bool qe::bit_kernels::parity(const word_type* a, size_t num_words) {
+	return kernels().parity(a, num_words);
+}
+
+size_t qe::bit_kernels::find_first_set(const word_type* a, size_t num_words) {
+	return kernels().find_first_set(a, num_words);
+}
+
+std::string_view qe::bit_kernels::implementation() {
+	return kernels().name;
+}
+
+std::vector<std::string_view> qe::bit_kernels::available_implementations() {
+	std::vector<std::string_view> names;
+	for (const auto* table : available_tables()) names.push_back(table->name);
+	return names;
+}
+
+bool qe::bit_kernels::select_implementation(std::string_view name) {
+	for (const auto* table : available_tables()) {
+		if (table->name == name) {
+			active_table().store(table, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
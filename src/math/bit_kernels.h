@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Word-parallel primitives on packed bit rows.
+	///
+	/// The implementation (scalar, SSE4.2/POPCNT, AVX2 or AVX-512) is chosen once at runtime
+	/// from the features of the host CPU, so the same binary runs at full speed on any x86-64
+	/// machine. On other architectures only the scalar implementation is available.
+	namespace bit_kernels {
+
+		using word_type = uint64_t;
+
+		/// @brief Below this many words, an inlined loop beats the call into the dispatched
+		///    kernels, so callers should only use the kernels for rows of at least this length.
+		inline constexpr size_t min_words = 4;
+
+		/// @brief target[k] ^= source[k] for all k < num_words.
+		void xor_into(word_type* target, const word_type* source, size_t num_words);
+
+		/// @brief target[k] ^= a[k] & b[k] for all k < num_words.
+		void xor_and_into(word_type* target, const word_type* a, const word_type* b, size_t num_words);
+
+		/// @brief Number of set bits in a.
+		size_t popcount(const word_type* a, size_t num_words);
+
+		/// @brief Number of set bits in (a & b).
+		size_t and_popcount(const word_type* a, const word_type* b, size_t num_words);
+
+		/// @brief Parity (sum modulo 2) of all bits in a.
+		bool parity(const word_type* a, size_t num_words);
+
+		/// @brief Index of the lowest set bit in a or num_words * 64 if all bits are zero.
+		size_t find_first_set(const word_type* a, size_t num_words);
+
+
+		/// @brief Name of the currently selected implementation.
+		std::string_view implementation();
+
+		/// @brief Names of all implementations that are supported on this CPU, from the most
+		///    basic ("scalar") to the most advanced.
+		std::vector<std::string_view> available_implementations();
+
+		/// @brief Select an implementation by name, e.g. for testing or benchmarking.
+		/// @return False if the implementation is not available on this CPU.
+		bool select_implementation(std::string_view name);
+
+	}
+
+}
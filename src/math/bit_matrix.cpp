@@ -0,0 +1,50 @@
+#include "bit_matrix.h"
+#include <bit>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+
+	constexpr size_t table_bits = 8;
+	constexpr size_t min_packed_dimension = 8;
+
+}
+
+
+BitMatrix qe::operator*(const BitMatrix& a, const BitMatrix& b) {
+	MATRIX_VERIFY(a.cols() == b.rows(), "Cannot multiply matrices with non-matching dimensions", Matrix_shape_error);
+	BitMatrix result(a.rows(), b.cols());
+	const size_t words = b.words_per_row();
+	std::vector<word_type> table((size_t{ 1 } << table_bits) * words);
+
+	for (size_t block = 0; block < a.cols(); block += table_bits) {
+		const size_t k = std::min(table_bits, a.cols() - block);
+
+		// Entry m holds the sum of the rows block + t of b for all bits t set in m.
+		for (size_t m = 1; m < (size_t{ 1 } << k); ++m) {
+			const word_type* previous = table.data() + (m & (m - 1)) * words;
+			const word_type* row = b.data() + (block + std::countr_zero(m)) * words;
+			word_type* entry = table.data() + m * words;
+			for (size_t w = 0; w < words; ++w) entry[w] = previous[w] ^ row[w];
+		}
+
+		for (size_t i = 0; i < a.rows(); ++i) {
+			const auto index = a.read_bits(i, block, k);
+			if (index == 0) continue;
+			const word_type* entry = table.data() + index * words;
+			word_type* target = result.data() + i * words;
+			if (words >= bit_kernels::min_words) bit_kernels::xor_into(target, entry, words);
+			else for (size_t w = 0; w < words; ++w) target[w] ^= entry[w];
+		}
+	}
+	return result;
+}
+
+Matrix<Binary> qe::operator*(const Matrix<Binary>& a, const Matrix<Binary>& b) {
+	if (std::min({ a.rows(), a.cols(), b.cols() }) < min_packed_dimension) {
+		return a.operator*(b);
+	}
+	return (BitMatrix{ a } * BitMatrix{ b }).to_matrix();
+}
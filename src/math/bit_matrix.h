@@ -0,0 +1,362 @@
+#pragma once
+
+#include "matrix.h"
+#include "binary.h"
+#include "bit_kernels.h"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Proxy reference to a single bit of a BitMatrix. Behaves like a Binary lvalue.
+	class BitReference {
+	public:
+		using word_type = uint64_t;
+
+		constexpr BitReference(word_type& word, word_type mask) noexcept : word(&word), mask(mask) {}
+
+		constexpr BitReference& operator=(Binary value) noexcept {
+			if (value == 1) *word |= mask;
+			else *word &= ~mask;
+			return *this;
+		}
+		constexpr BitReference& operator=(const BitReference& other) noexcept { return *this = Binary{ other }; }
+
+		constexpr BitReference& operator+=(Binary value) noexcept { if (value == 1) *word ^= mask; return *this; }
+		constexpr BitReference& operator*=(Binary value) noexcept { if (value == 0) *word &= ~mask; return *this; }
+		constexpr BitReference& negate() noexcept { *word ^= mask; return *this; }
+
+		explicit(false) constexpr operator Binary() const noexcept { return Binary{ (*word & mask) != 0 }; }
+		explicit constexpr operator bool() const noexcept { return (*word & mask) != 0; }
+		constexpr int to_int() const noexcept { return (*word & mask) != 0; }
+
+		constexpr friend bool operator==(const BitReference& a, const Binary& b) noexcept { return Binary{ a } == b; }
+
+	private:
+		word_type* word;
+		word_type mask;
+	};
+
+
+	/// @brief Dense matrix over F2 with each row packed into 64-bit words.
+	///
+	/// Bit j of row i is stored in bit (j % 64) of word (j / 64) of that row. Rows are padded
+	/// to whole words and the padding bits are always kept zero, so row operations can work
+	/// on complete words.
+	class BitMatrix {
+	public:
+		using word_type = uint64_t;
+		using size_type = Index;
+
+		static constexpr size_type word_bits = 64;
+
+
+		//
+		// Constructors
+		//
+
+		constexpr BitMatrix() = default;
+
+		constexpr BitMatrix(size_type rows, size_type cols)
+			: rows_(rows), cols_(cols), words_per_row_(words_for(cols)), data_(rows * words_for(cols)) {}
+
+		constexpr BitMatrix(size_type rows, size_type cols, Binary value) : BitMatrix(rows, cols) {
+			fill(value);
+		}
+
+		constexpr BitMatrix(size_type rows, size_type cols, const std::initializer_list<Binary> elems) : BitMatrix(rows, cols) {
+			size_type index{};
+			for (auto it = elems.begin(); it != elems.end() && index < size(); ++it, ++index) {
+				if (*it == 1) set(index / cols, index % cols);
+			}
+		}
+
+		template<Index m, Index n>
+		explicit constexpr BitMatrix(const Matrix<Binary, m, n>& mat) : BitMatrix(mat.rows(), mat.cols()) {
+			for (size_type i = 0; i < rows(); ++i) {
+				for (size_type j = 0; j < cols(); ++j) {
+					if (mat(i, j) == 1) set(i, j);
+				}
+			}
+		}
+
+		/// @brief Convert to a dense matrix of Binary elements.
+		constexpr Matrix<Binary> to_matrix() const {
+			Matrix<Binary> mat(rows(), cols());
+			for (size_type i = 0; i < rows(); ++i) {
+				for (size_type j = 0; j < cols(); ++j) {
+					mat(i, j) = get(i, j);
+				}
+			}
+			return mat;
+		}
+
+
+		//
+		// Size and access
+		//
+
+		constexpr size_type rows() const noexcept { return rows_; }
+		constexpr size_type cols() const noexcept { return cols_; }
+		constexpr size_type size() const noexcept { return rows_ * cols_; }
+		constexpr bool empty() const noexcept { return size() == 0; }
+
+		/// @brief Number of 64-bit words that make up one row.
+		constexpr size_type words_per_row() const noexcept { return words_per_row_; }
+
+		constexpr word_type* data() noexcept { return data_.data(); }
+		constexpr const word_type* data() const noexcept { return data_.data(); }
+
+		constexpr bool get(size_type i, size_type j) const noexcept { return (word(i, j) >> (j % word_bits)) & 1; }
+		constexpr void set(size_type i, size_type j) noexcept { word(i, j) |= bit(j); }
+		constexpr void set(size_type i, size_type j, bool value) noexcept { value ? set(i, j) : reset(i, j); }
+		constexpr void reset(size_type i, size_type j) noexcept { word(i, j) &= ~bit(j); }
+		constexpr void flip(size_type i, size_type j) noexcept { word(i, j) ^= bit(j); }
+
+		constexpr BitReference operator()(size_type i, size_type j) noexcept { return BitReference{ word(i, j), bit(j) }; }
+		constexpr Binary operator()(size_type i, size_type j) const noexcept { return Binary{ get(i, j) }; }
+
+		/// @brief Read k <= 64 consecutive bits of row i starting at column j. Bit t of the 
+		///    result holds element (i, j + t). 
+		constexpr word_type read_bits(size_type i, size_type j, size_type k) const noexcept {
+			const word_type* row = data_.data() + i * words_per_row_;
+			const size_type w = j / word_bits;
+			const size_type offset = j % word_bits;
+			word_type bits = row[w] >> offset;
+			if (offset != 0 && offset + k > word_bits && w + 1 < words_per_row_) bits |= row[w + 1] << (word_bits - offset);
+			return k == word_bits ? bits : bits & ((word_type{ 1 } << k) - 1);
+		}
+
+		/// @brief Access the packed words of a row.
+		constexpr std::span<word_type> row(size_type i) {
+			MATRIX_VERIFY(i < rows(), "Out of range error at BitMatrix::row()", Matrix_block_domain_error);
+			return { data_.data() + i * words_per_row_, words_per_row_ };
+		}
+		constexpr std::span<const word_type> row(size_type i) const {
+			MATRIX_VERIFY(i < rows(), "Out of range error at BitMatrix::row()", Matrix_block_domain_error);
+			return { data_.data() + i * words_per_row_, words_per_row_ };
+		}
+
+		/// @brief Copy a column into a (rows x 1) matrix. Columns are not contiguous in memory,
+		///    so unlike row() this cannot be a view.
+		constexpr BitMatrix col(size_type j) const {
+			MATRIX_VERIFY(j < cols(), "Out of range error at BitMatrix::col()", Matrix_block_domain_error);
+			BitMatrix result(rows(), 1);
+			for (size_type i = 0; i < rows(); ++i) {
+				if (get(i, j)) result.set(i, 0);
+			}
+			return result;
+		}
+
+		constexpr void fill(Binary value) {
+			std::fill(data_.begin(), data_.end(), value == 1 ? ~word_type{} : word_type{});
+			if (value == 1) clear_padding();
+		}
+
+		constexpr void clear() { fill(0); }
+
+		constexpr void swap(BitMatrix& other) noexcept {
+			std::swap(rows_, other.rows_);
+			std::swap(cols_, other.cols_);
+			std::swap(words_per_row_, other.words_per_row_);
+			data_.swap(other.data_);
+		}
+
+
+		//
+		// Row operations
+		//
+
+		/// @brief row(target) ^= row(source)
+		constexpr void xor_row(size_type target, size_type source) noexcept {
+			if (use_kernels()) {
+				bit_kernels::xor_into(row_data(target), row_data(source), words_per_row_);
+				return;
+			}
+			row_apply(target, source, [](word_type a, word_type b) { return a ^ b; });
+		}
+		/// @brief row(target) &= row(source)
+		constexpr void and_row(size_type target, size_type source) noexcept {
+			row_apply(target, source, [](word_type a, word_type b) { return a & b; });
+		}
+		/// @brief row(target) |= row(source)
+		constexpr void or_row(size_type target, size_type source) noexcept {
+			row_apply(target, source, [](word_type a, word_type b) { return a | b; });
+		}
+
+		constexpr void swap_rows(size_type i1, size_type i2) {
+			if (i1 == i2) return;
+			std::swap_ranges(row(i1).begin(), row(i1).end(), row(i2).begin());
+		}
+
+		constexpr void swap_cols(size_type j1, size_type j2) noexcept {
+			for (size_type i = 0; i < rows(); ++i) {
+				const bool b1 = get(i, j1);
+				set(i, j1, get(i, j2));
+				set(i, j2, b1);
+			}
+		}
+
+		/// @brief Number of set bits in the given row.
+		constexpr size_type row_count(size_type i) const {
+			if (use_kernels()) return bit_kernels::popcount(row_data(i), words_per_row_);
+			size_type count{};
+			for (auto w : row(i)) count += std::popcount(w);
+			return count;
+		}
+
+		/// @brief Number of columns that are set in both row i and row k.
+		constexpr size_type row_and_count(size_type i, size_type k) const {
+			if (use_kernels()) return bit_kernels::and_popcount(row_data(i), row_data(k), words_per_row_);
+			size_type count{};
+			for (size_type w = 0; w < words_per_row_; ++w) count += std::popcount(row_data(i)[w] & row_data(k)[w]);
+			return count;
+		}
+
+		/// @brief Parity of the number of set bits in the given row.
+		constexpr bool row_parity(size_type i) const {
+			if (use_kernels()) return bit_kernels::parity(row_data(i), words_per_row_);
+			word_type x{};
+			for (auto w : row(i)) x ^= w;
+			return std::popcount(x) & 1;
+		}
+
+		/// @brief Column of the first set bit in the given row or cols() if the row is zero.
+		constexpr size_type row_find_first(size_type i) const {
+			if (use_kernels()) return std::min(bit_kernels::find_first_set(row_data(i), words_per_row_), cols_);
+			for (size_type w = 0; w < words_per_row_; ++w) {
+				if (const auto x = row_data(i)[w]) return w * word_bits + std::countr_zero(x);
+			}
+			return cols_;
+		}
+
+		/// @brief Number of set bits in the entire matrix.
+		constexpr size_type count() const noexcept {
+			if (!std::is_constant_evaluated() && data_.size() >= bit_kernels::min_words) {
+				return bit_kernels::popcount(data_.data(), data_.size());
+			}
+			size_type count{};
+			for (auto w : data_) count += std::popcount(w);
+			return count;
+		}
+
+
+		//
+		// Arithmetic
+		//
+
+		constexpr BitMatrix& operator+=(const BitMatrix& other) { return apply(other, [](word_type a, word_type b) { return a ^ b; }); }
+		constexpr BitMatrix& operator-=(const BitMatrix& other) { return *this += other; }
+		constexpr BitMatrix& operator^=(const BitMatrix& other) { return *this += other; }
+		constexpr BitMatrix& operator&=(const BitMatrix& other) { return apply(other, [](word_type a, word_type b) { return a & b; }); }
+		constexpr BitMatrix& operator|=(const BitMatrix& other) { return apply(other, [](word_type a, word_type b) { return a | b; }); }
+
+		constexpr friend BitMatrix operator+(const BitMatrix& a, const BitMatrix& b) { return BitMatrix{ a } += b; }
+		constexpr friend BitMatrix operator-(const BitMatrix& a, const BitMatrix& b) { return BitMatrix{ a } -= b; }
+		constexpr friend BitMatrix operator^(const BitMatrix& a, const BitMatrix& b) { return BitMatrix{ a } ^= b; }
+		constexpr friend BitMatrix operator&(const BitMatrix& a, const BitMatrix& b) { return BitMatrix{ a } &= b; }
+		constexpr friend BitMatrix operator|(const BitMatrix& a, const BitMatrix& b) { return BitMatrix{ a } |= b; }
+
+		/// @brief Transpose the matrix, working on 64x64 blocks of bits at a time.
+		constexpr BitMatrix transpose() const {
+			BitMatrix result(cols(), rows());
+			word_type block[word_bits];
+			for (size_type bi = 0; bi < rows(); bi += word_bits) {
+				const size_type block_rows = std::min(word_bits, rows() - bi);
+				for (size_type bj = 0; bj < words_per_row_; ++bj) {
+					for (size_type k = 0; k < word_bits; ++k) {
+						block[k] = k < block_rows ? data_[(bi + k) * words_per_row_ + bj] : 0;
+					}
+					transpose64(block);
+					const size_type block_cols = std::min(word_bits, cols() - bj * word_bits);
+					for (size_type k = 0; k < block_cols; ++k) {
+						result.data_[(bj * word_bits + k) * result.words_per_row_ + bi / word_bits] = block[k];
+					}
+				}
+			}
+			return result;
+		}
+
+
+		//
+		// Factory functions
+		//
+
+		constexpr static BitMatrix zero(size_type m, size_type n) { return BitMatrix(m, n); }
+
+		constexpr static BitMatrix identity(size_type n) {
+			BitMatrix mat(n, n);
+			for (size_type i = 0; i < n; ++i) mat.set(i, i);
+			return mat;
+		}
+
+		friend constexpr bool operator==(const BitMatrix& a, const BitMatrix& b) {
+			return a.rows_ == b.rows_ && a.cols_ == b.cols_ && a.data_ == b.data_;
+		}
+
+		/// @brief In-place transpose of a 64x64 bit block given as 64 words (row k is block[k]).
+		static constexpr void transpose64(word_type* block) noexcept {
+			word_type m = 0x00000000FFFFFFFFULL;
+			for (size_type j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+				for (size_type k = 0; k < word_bits; k = ((k | j) + 1) & ~j) {
+					const word_type t = ((block[k] >> j) ^ block[k | j]) & m;
+					block[k] ^= t << j;
+					block[k | j] ^= t;
+				}
+			}
+		}
+
+		static constexpr size_type words_for(size_type bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+
+	private:
+		size_type rows_{};
+		size_type cols_{};
+		size_type words_per_row_{};
+		std::vector<word_type> data_;
+
+		constexpr word_type& word(size_type i, size_type j) noexcept { return data_[i * words_per_row_ + j / word_bits]; }
+		constexpr const word_type& word(size_type i, size_type j) const noexcept { return data_[i * words_per_row_ + j / word_bits]; }
+		static constexpr word_type bit(size_type j) noexcept { return word_type{ 1 } << (j % word_bits); }
+
+		constexpr bool use_kernels() const noexcept {
+			return !std::is_constant_evaluated() && words_per_row_ >= bit_kernels::min_words;
+		}
+
+		constexpr word_type* row_data(size_type i) noexcept { return data_.data() + i * words_per_row_; }
+		constexpr const word_type* row_data(size_type i) const noexcept { return data_.data() + i * words_per_row_; }
+
+		constexpr void clear_padding() noexcept {
+			if (cols_ % word_bits == 0) return;
+			const word_type mask = (word_type{ 1 } << (cols_ % word_bits)) - 1;
+			for (size_type i = 0; i < rows_; ++i) data_[(i + 1) * words_per_row_ - 1] &= mask;
+		}
+
+		template<class F>
+		constexpr void row_apply(size_type target, size_type source, F f) noexcept {
+			word_type* t = data_.data() + target * words_per_row_;
+			const word_type* s = data_.data() + source * words_per_row_;
+			for (size_type k = 0; k < words_per_row_; ++k) t[k] = f(t[k], s[k]);
+		}
+
+		template<class F>
+		constexpr BitMatrix& apply(const BitMatrix& other, F f) {
+			MATRIX_VERIFY(rows() == other.rows() && cols() == other.cols(), "Cannot operate matrices with non-matching dimensions", Matrix_shape_error);
+			std::transform(data_.begin(), data_.end(), other.data_.begin(), data_.begin(), f);
+			return *this;
+		}
+	};
+
+
+	/// @brief Matrix product over F2 with the Method of Four Russians: the rows of b are
+	///    grouped in blocks of 8 and each row of a picks a precomputed XOR combination of a block. 
+	BitMatrix operator*(const BitMatrix& a, const BitMatrix& b);
+
+	/// @brief Product of dynamic Binary matrices. Unless the matrices are tiny, they are packed 
+	///    and multiplied as BitMatrix, otherwise the generic Matrix::operator* is used. 
+	Matrix<Binary> operator*(const Matrix<Binary>& a, const Matrix<Binary>& b);
+
+}
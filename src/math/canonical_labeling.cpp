@@ -0,0 +1,241 @@
+#include "canonical_labeling.h"
+#include <bit>
+#include <numeric>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = uint64_t;
+	/// Ordered partition of the vertices, each cell given as a bit mask.
+	using Partition = std::vector<word_type>;
+	using Permutation = std::vector<int>;
+
+
+	/// Union-find over vertices for computing orbits of a set of permutations.
+	class Orbits {
+	public:
+		explicit Orbits(int n) : parent(n) { std::iota(parent.begin(), parent.end(), 0); }
+
+		int find(int v) {
+			while (parent[v] != v) v = parent[v] = parent[parent[v]];
+			return v;
+		}
+
+		void add(const Permutation& permutation) {
+			for (int v = 0; v < static_cast<int>(parent.size()); ++v) {
+				const int a = find(v);
+				const int b = find(permutation[v]);
+				if (a != b) parent[std::max(a, b)] = std::min(a, b);
+			}
+		}
+
+	private:
+		std::vector<int> parent;
+	};
+
+
+	/// Search tree of individualization and refinement.
+	class Search {
+	public:
+		explicit Search(const Graph& graph) : n(graph.num_vertices()), rows(n) {
+			assert(n <= 64 && "Canonical labeling is only supported for up to 64 vertices");
+			for (int v = 0; v < n; ++v) rows[v] = graph.adjacency_matrix.row(v)[0];
+		}
+
+		void run() {
+			if (n == 0) return;
+			Partition partition{ n == 64 ? ~word_type{} : (word_type{ 1 } << n) - 1 };
+			std::vector<int> prefix;
+			search(std::move(partition), prefix);
+		}
+
+		/// Vertex at each position of the canonical leaf.
+		std::vector<int> best_order;
+		/// Automorphisms found during the search.
+		std::vector<Permutation> generators;
+		/// Vertices individualized along the first path of the search tree.
+		std::vector<int> first_path;
+
+	private:
+		int n;
+		std::vector<word_type> rows;
+		bool has_leaf{};
+		std::vector<int> first_order;
+		std::vector<word_type> first_certificate;
+		std::vector<word_type> best_certificate;
+
+
+		/// Split cells by the number of neighbours in each splitter cell until the partition is
+		/// equitable. Every step only depends on the cell structure, so the result is
+		/// independent of the vertex labels.
+		void refine(Partition& partition) const {
+			bool changed = true;
+			while (changed) {
+				changed = false;
+				for (size_t s = 0; s < partition.size(); ++s) {
+					const word_type splitter = partition[s];
+					Partition refined;
+					refined.reserve(partition.size());
+					for (const word_type cell : partition) {
+						if (std::has_single_bit(cell)) {
+							refined.push_back(cell);
+							continue;
+						}
+						word_type groups[65]{};
+						word_type used_counts[2]{};
+						for (word_type bits = cell; bits; bits &= bits - 1) {
+							const int v = std::countr_zero(bits);
+							const int count = std::popcount(rows[v] & splitter);
+							groups[count] |= word_type{ 1 } << v;
+							used_counts[count / 64] |= word_type{ 1 } << (count % 64);
+						}
+						if (std::popcount(used_counts[0]) + std::popcount(used_counts[1]) == 1) {
+							refined.push_back(cell);
+							continue;
+						}
+						for (int count = 0; count <= 64; ++count) {
+							if (groups[count]) refined.push_back(groups[count]);
+						}
+						changed = true;
+					}
+					partition.swap(refined);
+				}
+			}
+		}
+
+		/// Returns the level to which the search should jump back or -1.
+		int search(Partition partition, std::vector<int>& prefix) {
+			refine(partition);
+			size_t target = 0;
+			while (target < partition.size() && std::has_single_bit(partition[target])) ++target;
+			if (target == partition.size()) return leaf(partition, prefix);
+
+			const int level = static_cast<int>(prefix.size());
+			const word_type cell = partition[target];
+			std::vector<int> explored;
+			for (word_type bits = cell; bits; bits &= bits - 1) {
+				const int v = std::countr_zero(bits);
+				if (equivalent_to_explored(v, explored, prefix)) continue;
+				explored.push_back(v);
+
+				Partition child = partition;
+				child[target] = word_type{ 1 } << v;
+				child.insert(child.begin() + target + 1, cell & ~(word_type{ 1 } << v));
+				if (!has_leaf) first_path.push_back(v);
+				prefix.push_back(v);
+				const int jump = search(std::move(child), prefix);
+				prefix.pop_back();
+				if (jump >= 0 && jump < level) return jump;
+			}
+			return -1;
+		}
+
+		int leaf(const Partition& partition, const std::vector<int>& prefix) {
+			std::vector<int> order(n);
+			for (int i = 0; i < n; ++i) order[i] = std::countr_zero(partition[i]);
+			auto certificate = relabeled_rows(order);
+
+			if (!has_leaf) {
+				has_leaf = true;
+				first_order = best_order = order;
+				first_certificate = best_certificate = std::move(certificate);
+				return -1;
+			}
+			if (certificate == first_certificate) {
+				add_automorphism(first_order, order);
+				// The subtree of the first path node where both paths diverge has now been covered.
+				size_t common = 0;
+				while (common < prefix.size() && prefix[common] == first_path[common]) ++common;
+				return static_cast<int>(common);
+			}
+			if (certificate == best_certificate) {
+				add_automorphism(best_order, order);
+			}
+			else if (certificate < best_certificate) {
+				best_order = std::move(order);
+				best_certificate = std::move(certificate);
+			}
+			return -1;
+		}
+
+		/// Adjacency rows after giving the vertex at position i the label i.
+		std::vector<word_type> relabeled_rows(const std::vector<int>& order) const {
+			std::vector<int> position(n);
+			for (int i = 0; i < n; ++i) position[order[i]] = i;
+			std::vector<word_type> result(n);
+			for (int i = 0; i < n; ++i) {
+				for (word_type bits = rows[order[i]]; bits; bits &= bits - 1) {
+					result[i] |= word_type{ 1 } << position[std::countr_zero(bits)];
+				}
+			}
+			return result;
+		}
+
+		/// Two leaves with the same relabeled graph differ by the automorphism from[i] -> to[i].
+		void add_automorphism(const std::vector<int>& from, const std::vector<int>& to) {
+			Permutation automorphism(n);
+			for (int i = 0; i < n; ++i) automorphism[from[i]] = to[i];
+			generators.push_back(std::move(automorphism));
+		}
+
+		/// Whether v lies in the orbit of an explored sibling under the automorphisms that fix
+		/// the prefix pointwise. The subtrees of such siblings contain the same relabeled graphs.
+		bool equivalent_to_explored(int v, const std::vector<int>& explored, const std::vector<int>& prefix) const {
+			if (explored.empty() || generators.empty()) return false;
+			Orbits orbits{ n };
+			for (const auto& generator : generators) {
+				const bool fixes_prefix = std::all_of(prefix.begin(), prefix.end(), [&](int u) { return generator[u] == u; });
+				if (fixes_prefix) orbits.add(generator);
+			}
+			const int orbit = orbits.find(v);
+			return std::any_of(explored.begin(), explored.end(), [&](int u) { return orbits.find(u) == orbit; });
+		}
+	};
+
+}
+
+
+CanonicalForm qe::canonical_form(const Graph& graph) {
+	Search search{ graph };
+	search.run();
+	std::vector<int> labeling(graph.num_vertices());
+	for (int i = 0; i < graph.num_vertices(); ++i) labeling[search.best_order[i]] = i;
+	auto canonical = graph.graph_isomorphism(labeling);
+	return CanonicalForm{ .labeling = std::move(labeling), .graph = std::move(canonical) };
+}
+
+AutomorphismGroup qe::automorphism_group(const Graph& graph) {
+	Search search{ graph };
+	search.run();
+	const int n = graph.num_vertices();
+	AutomorphismGroup group;
+
+	for (size_t level = 0; level < search.first_path.size(); ++level) {
+		Orbits orbits{ n };
+		for (const auto& generator : search.generators) {
+			const bool fixes_prefix = std::all_of(search.first_path.begin(), search.first_path.begin() + level, [&](int u) { return generator[u] == u; });
+			if (fixes_prefix) orbits.add(generator);
+		}
+		const int orbit = orbits.find(search.first_path[level]);
+		int orbit_size{};
+		for (int v = 0; v < n; ++v) orbit_size += orbits.find(v) == orbit;
+		group.order *= orbit_size;
+	}
+
+	Orbits orbits{ n };
+	for (const auto& generator : search.generators) orbits.add(generator);
+	group.orbits.resize(n);
+	for (int v = 0; v < n; ++v) group.orbits[v] = orbits.find(v);
+	group.generators = std::move(search.generators);
+	return group;
+}
+
+uint64_t qe::canonical_code(const Graph& graph) {
+	return Graph::compress(canonical_form(graph).graph);
+}
+
+bool qe::is_isomorphic(const Graph& graph1, const Graph& graph2) {
+	if (graph1.num_vertices() != graph2.num_vertices() || graph1.edge_count() != graph2.edge_count()) return false;
+	return canonical_form(graph1).graph == canonical_form(graph2).graph;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "graph.h"
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Canonical relabeling of a graph. Two graphs are isomorphic if and only if their
+	///    canonical graphs are equal.
+	struct CanonicalForm {
+		/// @brief Canonical label of each vertex, usable with Graph::graph_isomorphism().
+		std::vector<int> labeling;
+		/// @brief The relabeled graph, equal to graph.graph_isomorphism(labeling).
+		Graph graph;
+	};
+
+
+	/// @brief Automorphism group of a graph, i.e. all vertex permutations that map the graph
+	///    onto itself.
+	struct AutomorphismGroup {
+		/// @brief Permutations p (vertex v is mapped to p[v]) that generate the group.
+		std::vector<std::vector<int>> generators;
+		/// @brief Number of automorphisms (exact as long as it is below 2^53).
+		double order{ 1 };
+		/// @brief For each vertex the smallest vertex in its orbit under the group.
+		std::vector<int> orbits;
+	};
+
+
+	/// @brief Compute a canonical form in the style of nauty (McKay and Piperno).
+	///
+	/// Vertices are partitioned into cells by equitable refinement (repeatedly splitting cells
+	/// by the number of neighbours in other cells). If the partition is not discrete, each
+	/// vertex of the first non-singleton cell is individualized in turn and the partition is
+	/// refined again, which spans a search tree. Each leaf defines a labeling and the leaf with
+	/// the smallest relabeled adjacency matrix is canonical. Leaves with equal matrices yield
+	/// automorphisms, which are used to skip equivalent subtrees. Requires n <= 64.
+	CanonicalForm canonical_form(const Graph& graph);
+
+	/// @brief Compressed code (see Graph::compress()) of the canonical graph. Equal for two
+	///    graphs if and only if they are isomorphic. Requires n <= 11.
+	uint64_t canonical_code(const Graph& graph);
+
+	/// @brief Compute generators, order and vertex orbits of the automorphism group with the same
+	///    search as canonical_form(). Along the first path of the search tree, the found
+	///    generators that fix the individualized vertices generate the pointwise stabilizers,
+	///    so the order is the product of the orbit sizes of the vertices on that path.
+	AutomorphismGroup automorphism_group(const Graph& graph);
+
+	/// @brief Check whether two graphs are isomorphic by comparing their canonical forms.
+	bool is_isomorphic(const Graph& graph1, const Graph& graph2);
+
+}
@@ -0,0 +1,130 @@
+#include "cut_rank.h"
+#include "binary_linear_algebra.h"
+#include "thread_pool.h"
+#include <bit>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = uint64_t;
+
+	/// Adjacency rows of a graph with at most 64 vertices, one word per vertex.
+	std::vector<word_type> adjacency_words(const Graph& graph) {
+		assert(graph.num_vertices() <= 64 && "Bit mask cuts are only supported for up to 64 vertices");
+		std::vector<word_type> rows(graph.num_vertices());
+		for (int i = 0; i < graph.num_vertices(); ++i) rows[i] = graph.adjacency_matrix.row(i)[0];
+		return rows;
+	}
+
+	/// Rank of the given rows. The basis is kept with distinct leading bits in decreasing
+	/// order, so each row is reduced by min(x, x ^ b) without branches on the pivot.
+	class XorBasis {
+	public:
+		void insert(word_type x) {
+			for (int k = 0; k < size; ++k) x = std::min(x, x ^ basis[k]);
+			if (x == 0) return;
+			int k = size++;
+			for (; k > 0 && basis[k - 1] < x; --k) basis[k] = basis[k - 1];
+			basis[k] = x;
+		}
+		int rank() const { return size; }
+
+	private:
+		word_type basis[64]{};
+		int size{};
+	};
+
+	/// Cut-rank from masked rows where out[i] = row_i & ~subset. Rows are taken from the smaller
+	/// side of the cut, which has the same rank since the adjacency matrix is symmetric.
+	int masked_rank(const std::vector<word_type>& rows, const std::vector<word_type>& out, word_type subset, word_type all) {
+		const bool use_subset = std::popcount(subset) <= std::popcount(all & ~subset);
+		word_type side = use_subset ? subset : all & ~subset;
+		XorBasis basis;
+		for (; side; side &= side - 1) {
+			const int i = std::countr_zero(side);
+			basis.insert(use_subset ? out[i] : rows[i] ^ out[i]);
+		}
+		return basis.rank();
+	}
+
+	/// Cut-ranks for the Gray-code indices [begin, end).
+	void gray_code_cut_ranks(const std::vector<word_type>& rows, size_t begin, size_t end, std::vector<uint8_t>& ranks) {
+		const size_t n = rows.size();
+		const word_type all = n == 64 ? ~word_type{} : (word_type{ 1 } << n) - 1;
+		word_type subset = begin ^ (begin >> 1);
+		std::vector<word_type> out(n);
+		for (size_t i = 0; i < n; ++i) out[i] = rows[i] & ~subset;
+		ranks[subset] = static_cast<uint8_t>(masked_rank(rows, out, subset, all));
+
+		for (size_t k = begin + 1; k < end; ++k) {
+			const int v = std::countr_zero(k);
+			const word_type bit = word_type{ 1 } << v;
+			subset ^= bit;
+			for (word_type neighbours = rows[v]; neighbours; neighbours &= neighbours - 1) {
+				out[std::countr_zero(neighbours)] ^= bit;
+			}
+			ranks[subset] = static_cast<uint8_t>(masked_rank(rows, out, subset, all));
+		}
+	}
+
+}
+
+
+int qe::cut_rank(const Graph& graph, uint64_t subset) {
+	const auto rows = adjacency_words(graph);
+	const size_t n = rows.size();
+	const word_type all = n == 64 ? ~word_type{} : (word_type{ 1 } << n) - 1;
+	subset &= all;
+	std::vector<word_type> out(n);
+	for (size_t i = 0; i < n; ++i) out[i] = rows[i] & ~subset;
+	return masked_rank(rows, out, subset, all);
+}
+
+int qe::cut_rank(const Graph& graph, std::span<const int> subset) {
+	std::vector<bool> in_subset(graph.num_vertices());
+	for (int v : subset) in_subset[v] = true;
+	std::vector<int> complement;
+	for (int v = 0; v < graph.num_vertices(); ++v) {
+		if (!in_subset[v]) complement.push_back(v);
+	}
+	BitMatrix block(subset.size(), complement.size());
+	for (size_t i = 0; i < subset.size(); ++i) {
+		for (size_t j = 0; j < complement.size(); ++j) {
+			if (graph.has_edge(subset[i], complement[j])) block.set(i, j);
+		}
+	}
+	return static_cast<int>(rank(block));
+}
+
+std::vector<uint8_t> qe::cut_ranks(const Graph& graph, Q::ThreadPool* pool) {
+	const auto rows = adjacency_words(graph);
+	if (rows.empty()) return { 0 };
+	const size_t num_cuts = size_t{ 1 } << (rows.size() - 1);
+	std::vector<uint8_t> ranks(num_cuts);
+	if (pool) {
+		pool->parallel_for(num_cuts, [&](size_t begin, size_t end) { gray_code_cut_ranks(rows, begin, end, ranks); }, 1024);
+	}
+	else {
+		gray_code_cut_ranks(rows, 0, num_cuts, ranks);
+	}
+	return ranks;
+}
+
+std::vector<uint8_t> qe::cut_ranks(const Graph& graph, std::span<const uint64_t> subsets, Q::ThreadPool* pool) {
+	const auto rows = adjacency_words(graph);
+	const size_t n = rows.size();
+	const word_type all = n == 64 ? ~word_type{} : (word_type{ 1 } << n) - 1;
+	std::vector<uint8_t> ranks(subsets.size());
+	auto compute = [&](size_t begin, size_t end) {
+		std::vector<word_type> out(n);
+		for (size_t k = begin; k < end; ++k) {
+			const word_type subset = subsets[k] & all;
+			for (size_t i = 0; i < n; ++i) out[i] = rows[i] & ~subset;
+			ranks[k] = static_cast<uint8_t>(masked_rank(rows, out, subset, all));
+		}
+	};
+	if (pool) pool->parallel_for(subsets.size(), compute, 256);
+	else compute(0, subsets.size());
+	return ranks;
+}
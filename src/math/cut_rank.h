@@ -0,0 +1,36 @@
+#pragma once
+
+#include "graph.h"
+#include <span>
+#include <vector>
+
+namespace Q {
+	class ThreadPool;
+}
+
+
+namespace qe {
+
+	/// @brief Rank over F2 of the block of the adjacency matrix with rows in the given vertex
+	///    subset and columns in its complement. For a graph state, this is the entanglement
+	///    entropy (in ebits) across the bipartition.
+	/// @param subset Bit mask of the vertices on one side of the cut (requires n <= 64).
+	int cut_rank(const Graph& graph, uint64_t subset);
+
+	/// @brief Cut-rank for an arbitrary vertex subset, without restriction on the graph size.
+	int cut_rank(const Graph& graph, std::span<const int> subset);
+
+	/// @brief Cut-rank of every bipartition of the graph (requires n <= 64, practical up to ~30).
+	///
+	/// The cuts are visited in Gray-code order so that consecutive cuts differ by a single
+	/// vertex and the masked adjacency rows are updated in O(deg v) instead of being rebuilt.
+	/// @param pool If given, the Gray-code sequence is split into chunks that are processed
+	///    on the pool's threads.
+	/// @return Vector with 2^(n-1) entries where entry s is the cut-rank of the subset s of the
+	///    first n-1 vertices (the last vertex is always on the other side, so each cut appears once).
+	std::vector<uint8_t> cut_ranks(const Graph& graph, Q::ThreadPool* pool = nullptr);
+
+	/// @brief Cut-rank of a batch of vertex subsets given as bit masks (requires n <= 64).
+	std::vector<uint8_t> cut_ranks(const Graph& graph, std::span<const uint64_t> subsets, Q::ThreadPool* pool = nullptr);
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "bit_matrix.h"
+#include "fmt/format.h"
+
+
+template <>
+struct fmt::formatter<qe::BitMatrix> : formatter<string_view> {
+	auto format(const qe::BitMatrix& matrix, format_context& ctx) const {
+		for (size_t i = 0; i < matrix.rows(); ++i) {
+			fmt::format_to(ctx.out(), "| ");
+			for (size_t j = 0; j < matrix.cols(); ++j) {
+				fmt::format_to(ctx.out(), "{} ", matrix.get(i, j) ? 1 : 0);
+			}
+			fmt::format_to(ctx.out(), "|\n");
+		}
+		return ctx.out();
+	}
+};
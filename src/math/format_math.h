@@ -2,4 +2,5 @@
 
 #include "format_binary.h"
 #include "format_binary_phase.h"
+#include "format_bit_matrix.h"
 #include "format_matrix.h"
@@ -1,6 +1,9 @@
 ﻿#include "graph.h"
+#include "subgraphs.h"
+#include <algorithm>
 #include <bit>
 #include <iostream>
+#include <numeric>
 
 using namespace qe;
 
@@ -97,41 +100,77 @@ Graph qe::Graph::decompress(int num_vertices, uint64_t code) {
 }
 
 std::vector<std::vector<int>> qe::Graph::connected_components(bool sort_by_size) const {
+	using word_type = AdjacencyMatrix::word_type;
+	constexpr auto word_bits = AdjacencyMatrix::word_bits;
 	std::vector<std::vector<int>> components;
 
-	auto copy = adjacency_matrix;
-	auto edges = get_edges();
-	std::vector<int> remaining_vertices(num_vertices());
-	std::vector<int> visited(num_vertices());
-	std::iota(remaining_vertices.begin(), remaining_vertices.end(), 0);
+	// Depth-first search where all unvisited neighbours of a vertex are found with one 
+	// word operation per 64 vertices. 
+	const size_t num_words = adjacency_matrix.words_per_row();
+	std::vector<word_type> unvisited(num_words, ~word_type{});
+	if (num_vertices() % word_bits != 0) unvisited.back() = (word_type{ 1 } << (num_vertices() % word_bits)) - 1;
+	std::vector<int> stack;
 
 	for (int i = 0; i < num_vertices(); ++i) {
-		if (visited[i]) continue;
-		visited[i] = 1;
+		if (!(unvisited[i / word_bits] >> (i % word_bits) & 1)) continue;
+		unvisited[i / word_bits] &= ~(word_type{ 1 } << (i % word_bits));
 		std::vector<int> component{ i };
-		std::vector<int> queue{ i };
-		while (!queue.empty()) {
-			auto vertex = queue.back();
-			queue.pop_back();
-			for (int k = 0; k < num_vertices(); ++k) {
-				if (has_edge(vertex, k) && visited[k] == 0) {
-					queue.push_back(k);
+		stack.push_back(i);
+		while (!stack.empty()) {
+			const auto row = adjacency_matrix.row(stack.back());
+			stack.pop_back();
+			for (size_t w = 0; w < num_words; ++w) {
+				const word_type found = row[w] & unvisited[w];
+				unvisited[w] &= ~found;
+				for (word_type bits = found; bits; bits &= bits - 1) {
+					const int k = static_cast<int>(w * word_bits) + std::countr_zero(bits);
+					stack.push_back(k);
 					component.push_back(k);
-					visited[k] = 1;
 				}
 			}
 		}
 		components.emplace_back(std::move(component));
 	}
 	if (sort_by_size) {
-		// std::ranges::sort(components, std::less{}, &std::vector<int>::size);
-		std::sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
+		std::stable_sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
 			return a.size() < b.size();
 		});
 	}
 	return components;
 }
 
+int qe::Graph::connected_components(std::span<int> labels) const {
+	assert(labels.size() == static_cast<size_t>(num_vertices()) && "There needs to be one label per vertex");
+	const int n = num_vertices();
+	// Union-find in the label array, where the smaller root always becomes the parent. Then 
+	// each parent is smaller than its child and each root is the smallest vertex of its component. 
+	std::iota(labels.begin(), labels.end(), 0);
+	auto find = [&](int v) {
+		while (labels[v] != v) v = labels[v] = labels[labels[v]];
+		return v;
+	};
+	for (int i = 0; i < n; ++i) {
+		const auto row = adjacency_matrix.row(i);
+		for (size_t w = (i + 1) / AdjacencyMatrix::word_bits; w < row.size(); ++w) {
+			auto bits = row[w];
+			if (w == (i + 1) / AdjacencyMatrix::word_bits) bits &= ~AdjacencyMatrix::word_type{} << ((i + 1) % AdjacencyMatrix::word_bits);
+			for (; bits; bits &= bits - 1) {
+				const int j = static_cast<int>(w * AdjacencyMatrix::word_bits) + std::countr_zero(bits);
+				const int a = find(i);
+				const int b = find(j);
+				if (a != b) labels[std::max(a, b)] = std::min(a, b);
+			}
+		}
+	}
+	// In increasing order, the parent of v has already been replaced by the label of its 
+	// component, while roots still point to themselves. 
+	int count{};
+	for (int v = 0; v < n; ++v) {
+		labels[v] = labels[v] == v ? count++ : labels[labels[v]];
+	}
+	return count;
+}
+
 void qe::Graph::decompress_impl(Graph& graph, int64_t code) {
 	int index{};
 	for (int i = 0; i < graph.num_vertices() - 1; ++i) {
@@ -144,29 +183,16 @@ void qe::Graph::decompress_impl(Graph& graph, int64_t code) {
 
 
 std::vector<Graph> qe::generate_subgraphs(const Graph& graph, int min_edges, int max_edges) {
-	std::vector<std::pair<size_t, size_t>> edges;
+	// The range visits the masks grouped by edge count, but the result is ordered by mask.
+	const auto range = qe::subgraphs(graph, min_edges, max_edges);
+	std::vector<SubgraphRange::mask_type> masks;
+	masks.reserve(range.size());
+	for (auto it = range.begin(); it != range.end(); ++it) masks.push_back(it.mask());
+	std::sort(masks.begin(), masks.end());
+
 	std::vector<Graph> subgraphs;
-	for (int i = 0; i < graph.num_vertices(); ++i) {
-		for (int j = i + 1; j < graph.num_vertices(); ++j) {
-			if (graph.adjacency_matrix(i, j) == 1) edges.push_back({ i, j });
-		}
-	}
-	assert(edges.size() < 64 && "this algorithm only works with less than 64 edges");
-	const auto end = 1 << edges.size();
-	for (size_t i = 0; i < end; ++i) {
-		if (const auto edge_count = std::popcount(i);
-			edge_count < min_edges || edge_count > max_edges)
-			continue;
-
-		Graph subgraph(graph.num_vertices());
-		for (size_t j = 0; j < edges.size(); ++j) {
-			if (i & (1ULL << j)) {
-				subgraph.adjacency_matrix(edges[j].first, edges[j].second) = 1;
-				subgraph.adjacency_matrix(edges[j].second, edges[j].first) = 1;
-			}
-		}
-		subgraphs.push_back(subgraph);
-	}
+	subgraphs.reserve(masks.size());
+	for (const auto mask : masks) subgraphs.push_back(range.subgraph(mask));
 	return subgraphs;
 }
 
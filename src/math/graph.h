@@ -1,15 +1,17 @@
 ﻿
 #pragma once
-#include "matrix.h"
+#include "bit_matrix.h"
 #include "binary.h"
+#include <bit>
 #include <cstdint>
+#include <span>
 
 
 namespace qe {
 
 	class Graph {
 	public:
-		using AdjacencyMatrix = qe::Matrix<Binary, qe::dynamic, qe::dynamic>;
+		using AdjacencyMatrix = qe::BitMatrix;
 
 		AdjacencyMatrix adjacency_matrix;
 
@@ -35,7 +37,7 @@ namespace qe {
 		}
 
 		constexpr int edge_count() const {
-			return std::accumulate(adjacency_matrix.begin(), adjacency_matrix.end(), 0, [](int count, Binary b) { return count + b.to_int(); }) / 2;
+			return static_cast<int>(adjacency_matrix.count() / 2);
 		}
 
 		constexpr void add_edge(int vertex1, int vertex2) {
@@ -67,27 +69,92 @@ namespace qe {
 			adjacency_matrix(vertex2, vertex1).negate();
 		}
 
+		/// @brief Complement the neighbourhood of the given vertex. Since the vertex is 
+		///    not its own neighbour, this amounts to adding its row to the rows of all neighbours. 
+		///    The neighbours are enumerated from the set bits of the row, so only their rows are 
+		///    touched and nothing is allocated. 
 		constexpr void local_complementation(int vertex) {
-			qe::Matrix<Binary, qe::dynamic, qe::dynamic> ithColumn = adjacency_matrix.col(vertex);
-			adjacency_matrix += ithColumn * ithColumn.transpose();
-			for (int i = 0; i < num_vertices(); ++i) {
-				adjacency_matrix(i, i) = 0;
+			using word_type = AdjacencyMatrix::word_type;
+			constexpr auto word_bits = AdjacencyMatrix::word_bits;
+			auto& a = adjacency_matrix;
+			if (a.words_per_row() == 1) {
+				word_type* rows = a.data();
+				const word_type neighbourhood = rows[vertex];
+				for (word_type bits = neighbourhood; bits; bits &= bits - 1) {
+					const auto i = std::countr_zero(bits);
+					// Bit i of the neighbourhood is set, so excluding it keeps the diagonal zero.
+					rows[i] ^= neighbourhood ^ (word_type{ 1 } << i);
+				}
+				return;
+			}
+			for (size_t w = 0; w < a.words_per_row(); ++w) {
+				for (word_type bits = a.row(vertex)[w]; bits; bits &= bits - 1) {
+					const size_t i = w * word_bits + std::countr_zero(bits);
+					a.xor_row(i, vertex);
+					a.flip(i, i);
+				}
+			}
+		}
+
+		/// @brief Pivot on the edge (u, v), which equals the local complementations at u, v and u. 
+		///    With A = N(u) - N(v) - {v}, B = N(v) - N(u) - {u} and C = N(u) ∩ N(v), all edges 
+		///    between the classes A, B and C are complemented and u and v are exchanged. Only the 
+		///    rows of A, B, C, u and v are touched. 
+		constexpr void pivot(int u, int v) {
+			assert(has_edge(u, v) && "Pivoting requires an edge between both vertices");
+			using word_type = AdjacencyMatrix::word_type;
+			constexpr auto word_bits = AdjacencyMatrix::word_bits;
+			auto& a = adjacency_matrix;
+			if (a.words_per_row() == 1) {
+				word_type* rows = a.data();
+				const word_type nu = rows[u];
+				const word_type nv = rows[v];
+				const word_type uv = (word_type{ 1 } << u) | (word_type{ 1 } << v);
+				for (word_type bits = (nu | nv) & ~uv; bits; bits &= bits - 1) {
+					const auto x = std::countr_zero(bits);
+					const bool in_u = (nu >> x) & 1;
+					const bool in_v = (nv >> x) & 1;
+					// Rows of A gain B ∪ C and swap u for v, rows of B vice versa, rows of C gain A ∪ B. 
+					rows[x] ^= (in_u ? nv : 0) ^ (in_v ? nu : 0) ^ (in_u && in_v ? uv : in_u ? word_type{ 1 } << v : word_type{ 1 } << u);
+				}
+				rows[u] = nv ^ uv;
+				rows[v] = nu ^ uv;
+				return;
+			}
+			for (size_t w = 0; w < a.words_per_row(); ++w) {
+				for (word_type bits = a.row(u)[w] | a.row(v)[w]; bits; bits &= bits - 1) {
+					const size_t x = w * word_bits + std::countr_zero(bits);
+					if (x == static_cast<size_t>(u) || x == static_cast<size_t>(v)) continue;
+					const bool in_u = a.get(u, x);
+					const bool in_v = a.get(v, x);
+					if (in_u) a.xor_row(x, v);
+					if (in_v) a.xor_row(x, u);
+					if (in_u) a.flip(x, v);
+					if (in_v) a.flip(x, u);
+				}
 			}
+			a.swap_rows(u, v);
+			a.flip(u, u);
+			a.flip(u, v);
+			a.flip(v, u);
+			a.flip(v, v);
 		}
 
 		constexpr void swap(int vertex1, int vertex2) {
-			qe::Matrix<Binary, qe::dynamic, qe::dynamic> col = adjacency_matrix.col(vertex1);
-			adjacency_matrix.col(vertex1) = adjacency_matrix.col(vertex2);
-			adjacency_matrix.col(vertex2) = col;
-			qe::Matrix<Binary, qe::dynamic, qe::dynamic> row = adjacency_matrix.row(vertex1);
-			adjacency_matrix.row(vertex1) = adjacency_matrix.row(vertex2);
-			adjacency_matrix.row(vertex2) = row;
+			adjacency_matrix.swap_rows(vertex1, vertex2);
+			adjacency_matrix.swap_cols(vertex1, vertex2);
 		}
 
 		/// @brief Perform a series of local complementations
 		/// @param vertices Local complementations will be executed for vertices in the given order
 		constexpr void local_complementation(const std::initializer_list<int>& vertices) {
-			std::for_each(vertices.begin(), vertices.end(), [this](int vertex) { local_complementation(vertex); });
+			for (int vertex : vertices) local_complementation(vertex);
+		}
+
+		/// @brief Perform a series of local complementations
+		/// @param vertices Local complementations will be executed for vertices in the given order
+		constexpr void local_complementation(std::span<const int> vertices) {
+			for (int vertex : vertices) local_complementation(vertex);
 		}
 
 
@@ -98,7 +165,7 @@ namespace qe {
 			Graph result(num_vertices());
 			for (int i = 0; i < num_vertices() - 1; ++i) {
 				for (int j = i + 1; j < num_vertices(); ++j) {
-					result.adjacency_matrix(mapping[i], mapping[j]) = adjacency_matrix(i, j);
+					if (has_edge(i, j)) result.add_edge(mapping[i], mapping[j]);
 				}
 			}
 			return result;
@@ -111,44 +178,53 @@ namespace qe {
 
 		template<class Predicate>
 		static constexpr Graph transform(const Graph& g1, const Graph& g2, Predicate predicate) {
-			Graph result(g1.num_vertices());
-			std::transform(g1.adjacency_matrix.begin(), g1.adjacency_matrix.end(), g2.adjacency_matrix.begin(),
-				result.adjacency_matrix.begin(), predicate);
+			Graph result{ g1 };
+			result.transform(g2, predicate);
 			return result;
 		}
 
 		template<class Predicate>
 		constexpr void transform(const Graph& g, Predicate predicate) {
-			Graph result(num_vertices());
-			std::transform(adjacency_matrix.begin(), adjacency_matrix.end(), g.adjacency_matrix.begin(), adjacency_matrix.begin(), predicate);
+			for (int i = 0; i < num_vertices(); ++i) {
+				for (int j = 0; j < num_vertices(); ++j) {
+					adjacency_matrix(i, j) = predicate(adjacency_matrix(i, j), g.adjacency_matrix(i, j));
+				}
+			}
 		}
 
 		static constexpr Graph add(const Graph& g1, const Graph& g2) {
-			return Graph::transform(g1, g2, [](Binary b1, Binary b2) { return b1 | b2; });
+			Graph result{ g1 };
+			result.add(g2);
+			return result;
 		}
 
 		static constexpr Graph intersect(const Graph& g1, const Graph& g2) {
-			return Graph::transform(g1, g2, [](Binary b1, Binary b2) { return b1 & b2; });
+			Graph result{ g1 };
+			result.intersect(g2);
+			return result;
 		}
 
 		/// @brief Subtract edges of g2 from g1
 		static constexpr Graph subtract(const Graph& g1, const Graph& g2) {
-			return Graph::transform(g1, g2, [](Binary b1, Binary b2) { return b1 * b2.negate(); });
+			Graph result{ g1 };
+			result.subtract(g2);
+			return result;
 		}
 
 		/// @brief Add edges from other graph to this graph
 		constexpr void add(const Graph& g) {
-			transform(g, [](Binary b1, Binary b2) { return b1 | b2; });
+			adjacency_matrix |= g.adjacency_matrix;
 		}
 
 		/// @brief Form intersection of this graphs and the other graphs edges
 		constexpr void intersect(const Graph& g) {
-			transform(g, [](Binary b1, Binary b2) { return b1 & b2; });
+			adjacency_matrix &= g.adjacency_matrix;
 		}
 
 		/// @brief Remove all edges of this graph that occur in the other graph
 		constexpr void subtract(const Graph& g) {
-			transform(g, [](Binary b1, Binary b2) { return b1 * b2.negate(); });
+			adjacency_matrix |= g.adjacency_matrix;
+			adjacency_matrix ^= g.adjacency_matrix;
 		}
 
 		/// @brief Get all edges in form of integer pairs
@@ -172,10 +248,18 @@ namespace qe {
 		static Graph decompress(int num_vertices, uint64_t code);
 
 		/// @brief Get connected components of the graph in form of a vector of vector of vertex indices. 
+		///    The components are ordered by their smallest vertex. 
 		/// @param sort_by_size If true, the components are sorted by size (smallest to largest). 
 		/// @return Connected components of the graph
 		std::vector<std::vector<int>> connected_components(bool sort_by_size = false) const;
 
+		/// @brief Label each vertex with the index of its connected component without allocating. 
+		///    Components are numbered in the order of their smallest vertex, like the components 
+		///    returned by connected_components() (without sorting by size). 
+		/// @param labels Output with one entry per vertex. 
+		/// @return Number of connected components
+		int connected_components(std::span<int> labels) const;
+
 
 
 	private:
@@ -189,8 +273,9 @@ namespace qe {
 		}
 
 		constexpr Graph& make_star(int center) {
-			std::for_each(adjacency_matrix.col_begin(center), adjacency_matrix.col_end(center), [](Binary& el) { el.negate(); });
-			std::for_each(adjacency_matrix.row_begin(center), adjacency_matrix.row_end(center), [](Binary& el) { el.negate(); });
+			for (int i = 0; i < num_vertices(); ++i) {
+				if (i != center) toggle_edge(center, i);
+			}
 			return *this;
 		}
 
@@ -222,7 +307,10 @@ namespace qe {
 	void print_graph(const Graph& graph);
 
 
-	/// @brief Generate all subgraphs of given graph that have at least [min_edges] edges and at most [max_edges] edges
+	/// @brief Generate all subgraphs of given graph that have at least [min_edges] edges and at most [max_edges] edges. 
+	///    The subgraphs are ordered by their edge mask, where bit e stands for the e-th edge in 
+	///    row-major order (see SubgraphRange::edges()). Use subgraphs() from subgraphs.h to iterate 
+	///    over them without storing all of them (grouped by edge count instead). 
 	std::vector<Graph> generate_subgraphs(const Graph& graph, int min_edges, int max_edges);
 
 	std::vector<Graph> generate_subgraphs(const Graph& graph, int max_edges = std::numeric_limits<int>::max());
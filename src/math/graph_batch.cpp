@@ -0,0 +1,153 @@
+#include "graph_batch.h"
+#include "bit_kernels.h"
+#include <bit>
+
+using namespace qe;
+
+
+qe::GraphBatch::GraphBatch(int num_vertices, size_t size)
+	: num_vertices_(num_vertices), size_(size), words_((size + lanes_per_word - 1) / lanes_per_word),
+	  data_(num_slices() * words_) {}
+
+qe::GraphBatch::GraphBatch(const std::vector<Graph>& graphs)
+	: GraphBatch(graphs.empty() ? 0 : graphs.front().num_vertices(), graphs.size()) {
+	for (size_t g = 0; g < graphs.size(); ++g) set(g, graphs[g]);
+}
+
+Graph qe::GraphBatch::get(size_t index) const {
+	Graph graph(num_vertices_);
+	get(index, graph);
+	return graph;
+}
+
+void qe::GraphBatch::get(size_t index, Graph& graph) const {
+	assert(index < size_ && "Graph index out of range");
+	assert(graph.num_vertices() == num_vertices_ && "All graphs in a batch need to have the same number of vertices");
+	graph.adjacency_matrix.clear();
+	const size_t w = index / lanes_per_word;
+	const size_t shift = index % lanes_per_word;
+	size_t s{};
+	for (int i = 0; i < num_vertices_ - 1; ++i) {
+		for (int j = i + 1; j < num_vertices_; ++j, ++s) {
+			if ((data_[s * words_ + w] >> shift) & 1) graph.add_edge(i, j);
+		}
+	}
+}
+
+void qe::GraphBatch::set(size_t index, const Graph& graph) {
+	assert(index < size_ && "Graph index out of range");
+	assert(graph.num_vertices() == num_vertices_ && "All graphs in a batch need to have the same number of vertices");
+	const size_t w = index / lanes_per_word;
+	const word_type bit = word_type{ 1 } << (index % lanes_per_word);
+	size_t s{};
+	for (int i = 0; i < num_vertices_ - 1; ++i) {
+		for (int j = i + 1; j < num_vertices_; ++j, ++s) {
+			word_type& word = data_[s * words_ + w];
+			if (graph.has_edge(i, j)) word |= bit;
+			else word &= ~bit;
+		}
+	}
+}
+
+uint64_t qe::GraphBatch::code(size_t index) const {
+	assert(num_slices() <= 64 && "Compression is not supported for graphs of this size");
+	assert(index < size_ && "Graph index out of range");
+	const size_t w = index / lanes_per_word;
+	const size_t shift = index % lanes_per_word;
+	uint64_t code{};
+	for (size_t s = 0; s < num_slices(); ++s) {
+		code |= ((data_[s * words_ + w] >> shift) & 1) << s;
+	}
+	return code;
+}
+
+bool qe::GraphBatch::has_edge(size_t index, int vertex1, int vertex2) const {
+	if (vertex1 == vertex2) return false;
+	return (slice_data(vertex1, vertex2)[index / lanes_per_word] >> (index % lanes_per_word)) & 1;
+}
+
+std::span<GraphBatch::word_type> qe::GraphBatch::slice(int vertex1, int vertex2) {
+	return { slice_data(vertex1, vertex2), words_ };
+}
+
+std::span<const GraphBatch::word_type> qe::GraphBatch::slice(int vertex1, int vertex2) const {
+	return { slice_data(vertex1, vertex2), words_ };
+}
+
+void qe::GraphBatch::toggle_edge(int vertex1, int vertex2) {
+	word_type* s = slice_data(vertex1, vertex2);
+	for (size_t w = 0; w < words_; ++w) s[w] ^= lane_mask(w);
+}
+
+void qe::GraphBatch::toggle_edge(int vertex1, int vertex2, std::span<const word_type> lanes) {
+	assert(lanes.size() == words_ && "The lane mask needs to have words_per_slice() words");
+	word_type* s = slice_data(vertex1, vertex2);
+	for (size_t w = 0; w < words_; ++w) s[w] ^= lanes[w] & lane_mask(w);
+}
+
+void qe::GraphBatch::local_complementation(int vertex) {
+	// In every graph, the edge (a, b) between two vertices is toggled iff both are neighbours of vertex.
+	for (int a = 0; a < num_vertices_ - 1; ++a) {
+		if (a == vertex) continue;
+		const word_type* va = slice_data(vertex, a);
+		for (int b = a + 1; b < num_vertices_; ++b) {
+			if (b == vertex) continue;
+			bit_kernels::xor_and_into(slice_data(a, b), va, slice_data(vertex, b), words_);
+		}
+	}
+}
+
+void qe::GraphBatch::local_complementation(int vertex, std::span<const word_type> lanes) {
+	assert(lanes.size() == words_ && "The lane mask needs to have words_per_slice() words");
+	std::vector<word_type> masked(words_);
+	for (int a = 0; a < num_vertices_ - 1; ++a) {
+		if (a == vertex) continue;
+		const word_type* va = slice_data(vertex, a);
+		for (size_t w = 0; w < words_; ++w) masked[w] = va[w] & lanes[w];
+		for (int b = a + 1; b < num_vertices_; ++b) {
+			if (b == vertex) continue;
+			bit_kernels::xor_and_into(slice_data(a, b), masked.data(), slice_data(vertex, b), words_);
+		}
+	}
+}
+
+std::vector<int> qe::GraphBatch::edge_count() const {
+	// Bit plane p of the counters holds bit p of the edge count of every graph.
+	const size_t num_planes = std::bit_width(num_slices());
+	std::vector<word_type> planes(num_planes * words_);
+	for (size_t s = 0; s < num_slices(); ++s) {
+		const word_type* edges = data_.data() + s * words_;
+		for (size_t w = 0; w < words_; ++w) {
+			word_type carry = edges[w];
+			for (size_t p = 0; p < num_planes && carry; ++p) {
+				word_type& plane = planes[p * words_ + w];
+				const word_type next = plane & carry;
+				plane ^= carry;
+				carry = next;
+			}
+		}
+	}
+
+	std::vector<int> counts(size_);
+	for (size_t g = 0; g < size_; ++g) {
+		const size_t w = g / lanes_per_word;
+		const size_t shift = g % lanes_per_word;
+		int count{};
+		for (size_t p = 0; p < num_planes; ++p) {
+			count |= static_cast<int>((planes[p * words_ + w] >> shift) & 1) << p;
+		}
+		counts[g] = count;
+	}
+	return counts;
+}
+
+size_t qe::GraphBatch::slice_index(int vertex1, int vertex2) const {
+	assert(vertex1 != vertex2 && "There are no edges from a vertex to itself");
+	const auto [i, j] = std::minmax(vertex1, vertex2);
+	return static_cast<size_t>(i * (2 * num_vertices_ - i - 1) / 2 + (j - i - 1));
+}
+
+GraphBatch::word_type qe::GraphBatch::lane_mask(size_t w) const {
+	const size_t remaining = size_ - w * lanes_per_word;
+	return remaining >= lanes_per_word ? ~word_type{} : (word_type{ 1 } << remaining) - 1;
+}
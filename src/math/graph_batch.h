@@ -0,0 +1,88 @@
+#pragma once
+
+#include "graph.h"
+#include <span>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Many graphs with the same number of vertices stored bit-sliced (transposed).
+	///
+	/// For each vertex pair i < j there is one slice of words_per_slice() words in which bit g
+	/// tells whether graph g has the edge (i, j). An operation that is the same for all graphs,
+	/// like a local complementation at a fixed vertex, thus processes 64 graphs per word and up
+	/// to 512 graphs per SIMD instruction. Lanes beyond size() are always kept zero.
+	///
+	/// The slices are ordered like the bits of Graph::compress().
+	class GraphBatch {
+	public:
+		using word_type = uint64_t;
+		static constexpr size_t lanes_per_word = 64;
+
+
+		/// @brief Create a batch of size graphs without edges.
+		GraphBatch(int num_vertices, size_t size);
+
+		/// @brief Create a batch from graphs which all need to have the same number of vertices.
+		explicit GraphBatch(const std::vector<Graph>& graphs);
+
+
+		int num_vertices() const { return num_vertices_; }
+		size_t size() const { return size_; }
+		size_t words_per_slice() const { return words_; }
+		size_t num_slices() const { return static_cast<size_t>(num_vertices_ * (num_vertices_ - 1) / 2); }
+
+
+		Graph get(size_t index) const;
+
+		/// @brief Overwrite a graph with num_vertices() vertices with graph index without allocating.
+		void get(size_t index, Graph& graph) const;
+
+		void set(size_t index, const Graph& graph);
+
+		/// @brief Compressed form of graph index, identical to Graph::compress(get(index)).
+		uint64_t code(size_t index) const;
+
+		bool has_edge(size_t index, int vertex1, int vertex2) const;
+
+		/// @brief Edge slice of the vertex pair (vertex1, vertex2) with one bit per graph.
+		std::span<word_type> slice(int vertex1, int vertex2);
+		std::span<const word_type> slice(int vertex1, int vertex2) const;
+
+
+		/// @brief Toggle the edge (vertex1, vertex2) in every graph.
+		void toggle_edge(int vertex1, int vertex2);
+
+		/// @brief Toggle the edge (vertex1, vertex2) in all graphs whose bit is set in lanes.
+		/// @param lanes Lane mask with words_per_slice() words.
+		void toggle_edge(int vertex1, int vertex2, std::span<const word_type> lanes);
+
+		/// @brief Perform a local complementation at vertex in every graph.
+		void local_complementation(int vertex);
+
+		/// @brief Perform a local complementation at vertex in all graphs whose bit is set in lanes.
+		/// @param lanes Lane mask with words_per_slice() words.
+		void local_complementation(int vertex, std::span<const word_type> lanes);
+
+		/// @brief Number of edges of each graph. The counts are accumulated for all graphs at
+		///    once in bit-sliced binary counters.
+		std::vector<int> edge_count() const;
+
+		friend bool operator==(const GraphBatch&, const GraphBatch&) = default;
+
+	private:
+		int num_vertices_{};
+		size_t size_{};
+		size_t words_{};
+		std::vector<word_type> data_;
+
+		size_t slice_index(int vertex1, int vertex2) const;
+		word_type* slice_data(int vertex1, int vertex2) { return data_.data() + slice_index(vertex1, vertex2) * words_; }
+		const word_type* slice_data(int vertex1, int vertex2) const { return data_.data() + slice_index(vertex1, vertex2) * words_; }
+
+		/// Mask of the valid lanes in word w.
+		word_type lane_mask(size_t w) const;
+	};
+
+}
@@ -0,0 +1,103 @@
+#include "graph_code.h"
+#include <bit>
+#include <cassert>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = GraphCode::word_type;
+	constexpr size_t word_bits = GraphCode::word_bits;
+
+	constexpr word_type low_mask(size_t count) {
+		return count >= word_bits ? ~word_type{} : (word_type{ 1 } << count) - 1;
+	}
+
+	/// Bits [begin, begin + count) of a bit string with count <= 64.
+	word_type extract(std::span<const word_type> bits, size_t begin, size_t count) {
+		const size_t word = begin / word_bits;
+		const size_t offset = begin % word_bits;
+		word_type value = bits[word] >> offset;
+		if (offset != 0 && offset + count > word_bits) value |= bits[word + 1] << (word_bits - offset);
+		return value & low_mask(count);
+	}
+
+	/// Write count <= 64 bits to the zero-initialized range starting at position.
+	void deposit(std::span<word_type> bits, size_t position, word_type value, size_t count) {
+		const size_t word = position / word_bits;
+		const size_t offset = position % word_bits;
+		bits[word] |= value << offset;
+		if (offset != 0 && offset + count > word_bits) bits[word + 1] |= value >> (word_bits - offset);
+	}
+
+	size_t index(int n, int i, int j) {
+		return static_cast<size_t>(i) * (2 * n - i - 1) / 2 + (j - i - 1);
+	}
+
+}
+
+
+GraphCode::GraphCode(const Graph& graph) : num_vertices_(graph.num_vertices()), words_(words_for(graph.num_vertices())) {
+	const int n = num_vertices_;
+	size_t position{};
+	for (int i = 0; i < n - 1; ++i) {
+		const auto row = graph.adjacency_matrix.row(i);
+		for (size_t j = i + 1; j < static_cast<size_t>(n); j += word_bits) {
+			const size_t count = std::min(word_bits, n - j);
+			deposit(words_, position, extract(row, j, count), count);
+			position += count;
+		}
+	}
+}
+
+GraphCode::GraphCode(int num_vertices, std::vector<word_type> words) : num_vertices_(num_vertices), words_(std::move(words)) {
+	assert(words_.size() == words_for(num_vertices) && "Number of words does not match the number of vertices");
+	assert((words_.empty() || (words_.back() & ~low_mask(num_bits() - (words_.size() - 1) * word_bits)) == 0) &&
+		   "Bits beyond the upper triangle need to be zero");
+}
+
+Graph GraphCode::to_graph() const {
+	const int n = num_vertices_;
+	Graph graph{ n };
+	size_t position{};
+	for (int i = 0; i < n - 1; ++i) {
+		for (size_t j = i + 1; j < static_cast<size_t>(n); j += word_bits) {
+			const size_t count = std::min(word_bits, n - j);
+			for (word_type bits = extract(words_, position, count); bits; bits &= bits - 1) {
+				graph.add_edge(i, static_cast<int>(j) + std::countr_zero(bits));
+			}
+			position += count;
+		}
+	}
+	return graph;
+}
+
+bool GraphCode::has_edge(int vertex1, int vertex2) const {
+	if (vertex1 == vertex2) return false;
+	const size_t bit = index(num_vertices_, std::min(vertex1, vertex2), std::max(vertex1, vertex2));
+	return (words_[bit / word_bits] >> (bit % word_bits)) & 1;
+}
+
+size_t GraphCode::hash() const noexcept {
+	// Combine the words with the SplitMix64 finalizer.
+	word_type h = static_cast<word_type>(num_vertices_);
+	for (const word_type word : words_) {
+		h ^= word + 0x9E37'79B9'7F4A'7C15 + (h << 6) + (h >> 2);
+		h = (h ^ (h >> 30)) * 0xBF58'476D'1CE4'E5B9;
+		h = (h ^ (h >> 27)) * 0x94D0'49BB'1331'11EB;
+		h ^= h >> 31;
+	}
+	return static_cast<size_t>(h);
+}
+
+namespace qe {
+
+	std::strong_ordering operator<=>(const GraphCode& a, const GraphCode& b) noexcept {
+		if (const auto cmp = a.num_vertices_ <=> b.num_vertices_; cmp != 0) return cmp;
+		for (size_t w = a.words_.size(); w-- > 0;) {
+			if (const auto cmp = a.words_[w] <=> b.words_[w]; cmp != 0) return cmp;
+		}
+		return std::strong_ordering::equal;
+	}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "graph.h"
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Compressed form of a graph of arbitrary size.
+	///
+	/// The upper triangle of the adjacency matrix is stored row by row, i.e. the edge (i, j) with
+	/// i < j is bit i(2n - i - 1)/2 + j - i - 1, in as many 64-bit words as needed. For up to 11
+	/// vertices, the code consists of a single word equal to Graph::compress(). Codes are ordered
+	/// by the number of vertices first and then as binary numbers and can be used as keys of
+	/// hashed containers.
+	class GraphCode {
+	public:
+		using word_type = uint64_t;
+		static constexpr size_t word_bits = 64;
+
+		GraphCode() = default;
+
+		explicit GraphCode(const Graph& graph);
+
+		/// @brief Create a code from its words. Bits beyond the upper triangle need to be zero.
+		GraphCode(int num_vertices, std::vector<word_type> words);
+
+		Graph to_graph() const;
+
+		int num_vertices() const { return num_vertices_; }
+		size_t num_bits() const { return bits_for(num_vertices_); }
+		std::span<const word_type> words() const { return words_; }
+
+		bool has_edge(int vertex1, int vertex2) const;
+
+		size_t hash() const noexcept;
+
+		friend bool operator==(const GraphCode&, const GraphCode&) = default;
+		friend std::strong_ordering operator<=>(const GraphCode& a, const GraphCode& b) noexcept;
+
+		static constexpr size_t bits_for(int num_vertices) {
+			return static_cast<size_t>(num_vertices) * (num_vertices - (num_vertices > 0)) / 2;
+		}
+		static constexpr size_t words_for(int num_vertices) { return (bits_for(num_vertices) + word_bits - 1) / word_bits; }
+
+	private:
+		int num_vertices_{};
+		std::vector<word_type> words_;
+	};
+
+}
+
+
+template<>
+struct std::hash<qe::GraphCode> {
+	size_t operator()(const qe::GraphCode& code) const noexcept { return code.hash(); }
+};
@@ -0,0 +1,116 @@
+#include "graph_invariants.h"
+#include "bit_kernels.h"
+#include "graph_batch.h"
+#include "thread_pool.h"
+#include <bit>
+
+using namespace qe;
+
+namespace {
+
+	/// SplitMix64 finalizer. Summing mixed values gives a hash of a multiset that does not
+	/// depend on the order of its elements.
+	uint64_t mix(uint64_t x) {
+		x += 0x9E37'79B9'7F4A'7C15;
+		x = (x ^ (x >> 30)) * 0xBF58'476D'1CE4'E5B9;
+		x = (x ^ (x >> 27)) * 0x94D0'49BB'1331'11EB;
+		return x ^ (x >> 31);
+	}
+
+
+	/// Colour refinement with buffers that are reused for all graphs hashed by one thread.
+	class WlHasher {
+	public:
+		uint64_t operator()(const Graph& graph, int rounds) {
+			const int n = graph.num_vertices();
+			const auto& matrix = graph.adjacency_matrix;
+			const size_t num_words = matrix.words_per_row();
+			colours.resize(n);
+			next.resize(n);
+
+			int degree_sum{};
+			for (int v = 0; v < n; ++v) {
+				const auto row = matrix.row(v);
+				const int degree = static_cast<int>(bit_kernels::popcount(row.data(), num_words));
+				size_t triangles{};
+				for_each_neighbour(row, [&](int u) { triangles += bit_kernels::and_popcount(row.data(), matrix.row(u).data(), num_words); });
+				colours[v] = mix((static_cast<uint64_t>(degree) << 32) | (triangles / 2));
+				degree_sum += degree;
+			}
+
+			for (int round = 0; round < rounds; ++round) {
+				for (int v = 0; v < n; ++v) {
+					uint64_t neighbourhood{};
+					for_each_neighbour(matrix.row(v), [&](int u) { neighbourhood += mix(colours[u] ^ 0xA5A5'A5A5'A5A5'A5A5); });
+					next[v] = mix(colours[v] + mix(neighbourhood));
+				}
+				colours.swap(next);
+			}
+
+			uint64_t colour_sum{};
+			for (const uint64_t colour : colours) colour_sum += mix(colour);
+			return mix(mix((static_cast<uint64_t>(n) << 32) | static_cast<uint64_t>(degree_sum / 2)) + colour_sum);
+		}
+
+	private:
+		std::vector<uint64_t> colours;
+		std::vector<uint64_t> next;
+
+		template<class F>
+		static void for_each_neighbour(std::span<const uint64_t> row, F&& f) {
+			for (size_t w = 0; w < row.size(); ++w) {
+				for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+					f(static_cast<int>(w * 64 + std::countr_zero(bits)));
+				}
+			}
+		}
+	};
+
+}
+
+
+std::vector<int> qe::triangle_counts(const Graph& graph) {
+	const auto& matrix = graph.adjacency_matrix;
+	const size_t num_words = matrix.words_per_row();
+	std::vector<int> counts(graph.num_vertices());
+	for (int v = 0; v < graph.num_vertices(); ++v) {
+		const auto row = matrix.row(v);
+		size_t count{};
+		for (int u = 0; u < graph.num_vertices(); ++u) {
+			if (graph.has_edge(v, u)) count += bit_kernels::and_popcount(row.data(), matrix.row(u).data(), num_words);
+		}
+		// Every edge among the neighbours is counted from both of its endpoints.
+		counts[v] = static_cast<int>(count / 2);
+	}
+	return counts;
+}
+
+uint64_t qe::wl_hash(const Graph& graph, int rounds) {
+	return WlHasher{}(graph, rounds);
+}
+
+std::vector<uint64_t> qe::wl_hash(std::span<const Graph> graphs, int rounds, Q::ThreadPool* pool) {
+	std::vector<uint64_t> hashes(graphs.size());
+	auto hash_range = [&](size_t begin, size_t end) {
+		WlHasher hasher;
+		for (size_t i = begin; i < end; ++i) hashes[i] = hasher(graphs[i], rounds);
+	};
+	if (pool) pool->parallel_for(graphs.size(), hash_range, 64);
+	else hash_range(0, graphs.size());
+	return hashes;
+}
+
+std::vector<uint64_t> qe::wl_hash(const GraphBatch& batch, int rounds, Q::ThreadPool* pool) {
+	std::vector<uint64_t> hashes(batch.size());
+	auto hash_range = [&](size_t begin, size_t end) {
+		WlHasher hasher;
+		Graph graph(batch.num_vertices());
+		for (size_t i = begin; i < end; ++i) {
+			batch.get(i, graph);
+			hashes[i] = hasher(graph, rounds);
+		}
+	};
+	if (pool) pool->parallel_for(batch.size(), hash_range, 64);
+	else hash_range(0, batch.size());
+	return hashes;
+}
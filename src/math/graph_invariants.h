@@ -0,0 +1,43 @@
+#pragma once
+
+#include "graph.h"
+#include <span>
+#include <vector>
+
+namespace Q {
+	class ThreadPool;
+}
+
+
+namespace qe {
+
+	class GraphBatch;
+
+
+	/// @brief Number of triangles through each vertex, i.e. the number of edges among its
+	///    neighbours. Each count is a sum of AND-popcounts of adjacency rows.
+	std::vector<int> triangle_counts(const Graph& graph);
+
+	/// @brief Isomorphism-invariant 64-bit hash in the style of the Weisfeiler-Lehman test.
+	///
+	/// Each vertex starts with a colour derived from its degree and triangle count. In each
+	/// round, the colour of a vertex is replaced by a hash of its colour and the multiset of
+	/// the colours of its neighbours (combined by a commutative sum of mixed values). The
+	/// graph hash combines the number of vertices, the number of edges and the multiset of
+	/// final colours.
+	///
+	/// Isomorphic graphs always have the same hash, so graphs with different hashes can be
+	/// rejected before a full isomorphism test. The converse does not hold: for example,
+	/// regular graphs with the same degree and triangle counts are not distinguished.
+	/// @param rounds Number of refinement rounds.
+	uint64_t wl_hash(const Graph& graph, int rounds = 3);
+
+	/// @brief Compute wl_hash() for many graphs, reusing the working memory between graphs.
+	/// @param pool If given, the graphs are split into chunks that are hashed in parallel.
+	std::vector<uint64_t> wl_hash(std::span<const Graph> graphs, int rounds = 3, Q::ThreadPool* pool = nullptr);
+
+	/// @brief Compute wl_hash() for all graphs of a batch. Each graph is decoded from the
+	///    bit slices into a scratch graph that is reused along with the working memory.
+	std::vector<uint64_t> wl_hash(const GraphBatch& batch, int rounds = 3, Q::ThreadPool* pool = nullptr);
+
+}
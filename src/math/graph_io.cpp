@@ -0,0 +1,267 @@
+#include "graph_io.h"
+#include <bit>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+
+	constexpr std::string_view graph6_header = ">>graph6<<";
+	constexpr std::string_view sparse6_header = ">>sparse6<<";
+
+	/// Number of bits needed to write the vertex n - 1 in sparse6.
+	int vertex_bits(size_t n) {
+		return n <= 1 ? 0 : std::bit_width(n - 1);
+	}
+
+	void reset(Graph& graph, int num_vertices) {
+		if (graph.num_vertices() == num_vertices) graph.clear();
+		else graph = Graph{ num_vertices };
+	}
+
+
+	/// Appends bits most significant first and emits a printable character per six bits.
+	class SixBitWriter {
+	public:
+		explicit SixBitWriter(std::string& out) : out(out) {}
+
+		void push(word_type bits, int width) {
+			for (int b = width - 1; b >= 0; --b) {
+				value = (value << 1) | ((bits >> b) & 1);
+				if (++count == 6) flush();
+			}
+		}
+
+		int pending() const { return count; }
+
+		/// Complete the last character with zeros.
+		void finish() {
+			if (count != 0) push(0, 6 - count);
+		}
+
+	private:
+		std::string& out;
+		unsigned int value{};
+		int count{};
+
+		void flush() {
+			out.push_back(static_cast<char>(63 + value));
+			value = 0;
+			count = 0;
+		}
+	};
+
+	/// Reads bits most significant first from a string of printable characters.
+	class SixBitReader {
+	public:
+		explicit SixBitReader(std::string_view data) : data(data) {}
+
+		size_t remaining() const { return 6 * data.size() - position; }
+
+		word_type read(int width) {
+			word_type bits{};
+			for (int b = 0; b < width; ++b, ++position) {
+				bits = (bits << 1) | ((digit(data[position / 6]) >> (5 - position % 6)) & 1);
+			}
+			return bits;
+		}
+
+	private:
+		std::string_view data;
+		size_t position{};
+
+		static unsigned int digit(char c) { return static_cast<unsigned int>(c) - 63; }
+	};
+
+
+	void check_characters(std::string_view str) {
+		for (const char c : str) {
+			if (c < 63 || c > 126) throw Graph_format_error{ "Invalid character in graph6/sparse6 string" };
+		}
+	}
+
+	void append_size(std::string& out, size_t n) {
+		if (n <= 62) {
+			out.push_back(static_cast<char>(63 + n));
+			return;
+		}
+		const int digits = n <= 258047 ? 3 : 6;
+		out.append(digits == 3 ? 1 : 2, '~');
+		for (int d = digits - 1; d >= 0; --d) out.push_back(static_cast<char>(63 + ((n >> (6 * d)) & 63)));
+	}
+
+	/// Parse the number of vertices and advance str past it.
+	int parse_size(std::string_view& str) {
+		auto take = [&](size_t count) {
+			if (str.size() < count) throw Graph_format_error{ "Truncated number of vertices" };
+			size_t n{};
+			for (size_t i = 0; i < count; ++i) n = (n << 6) | static_cast<size_t>(str[i] - 63);
+			str.remove_prefix(count);
+			return n;
+		};
+		if (str.empty()) throw Graph_format_error{ "Empty graph6/sparse6 string" };
+		size_t n{};
+		if (str[0] != '~') n = take(1);
+		else if (str.size() < 2 || str[1] != '~') {
+			str.remove_prefix(1);
+			n = take(3);
+		}
+		else {
+			str.remove_prefix(2);
+			n = take(6);
+		}
+		if (n > static_cast<size_t>(std::numeric_limits<int>::max())) throw Graph_format_error{ "Too many vertices" };
+		return static_cast<int>(n);
+	}
+
+
+	void append_graph6(std::string& out, const Graph& graph) {
+		const int n = graph.num_vertices();
+		append_size(out, n);
+		SixBitWriter writer{ out };
+		for (int j = 1; j < n; ++j) {
+			for (int i = 0; i < j; ++i) writer.push(graph.has_edge(i, j), 1);
+		}
+		writer.finish();
+	}
+
+	void append_sparse6(std::string& out, const Graph& graph) {
+		const int n = graph.num_vertices();
+		const int k = vertex_bits(n);
+		out.push_back(':');
+		append_size(out, n);
+		SixBitWriter writer{ out };
+		int current{};
+		for (int j = 0; j < n; ++j) {
+			const auto row = graph.adjacency_matrix.row(j);
+			for (size_t w = 0; w * 64 < static_cast<size_t>(j); ++w) {
+				word_type bits = row[w];
+				if ((w + 1) * 64 > static_cast<size_t>(j)) bits &= (word_type{ 1 } << (j % 64)) - 1;
+				for (; bits; bits &= bits - 1) {
+					const int i = static_cast<int>(w * 64) + std::countr_zero(bits);
+					if (j == current) {
+						writer.push(0, 1);
+					}
+					else if (j == current + 1) {
+						writer.push(1, 1);
+					}
+					else {
+						writer.push(1, 1);
+						writer.push(j, k);
+						writer.push(0, 1);
+					}
+					writer.push(i, k);
+					current = j;
+				}
+			}
+		}
+		if (writer.pending() != 0) {
+			const int padding = 6 - writer.pending();
+			// Padding with ones could otherwise be read as an edge (n-1, n-1).
+			if (k < 6 && n == (1 << k) && current == n - 2 && padding >= k + 1) writer.push(0, 1);
+			writer.push(~word_type{}, 6 - writer.pending());
+		}
+	}
+
+	void parse_graph6(std::string_view str, Graph& graph) {
+		check_characters(str);
+		const int n = parse_size(str);
+		const size_t num_bits = static_cast<size_t>(n) * (n - (n > 0)) / 2;
+		if (str.size() != (num_bits + 5) / 6) throw Graph_format_error{ "Length of graph6 string does not match the number of vertices" };
+		reset(graph, n);
+		SixBitReader reader{ str };
+		for (int j = 1; j < n; ++j) {
+			for (int i = 0; i < j; ++i) {
+				if (reader.read(1)) graph.add_edge(i, j);
+			}
+		}
+	}
+
+	void parse_sparse6(std::string_view str, Graph& graph) {
+		if (str.empty() || str[0] != ':') throw Graph_format_error{ "sparse6 string needs to start with ':'" };
+		str.remove_prefix(1);
+		check_characters(str);
+		const int n = parse_size(str);
+		const int k = vertex_bits(n);
+		reset(graph, n);
+		SixBitReader reader{ str };
+		size_t v{};
+		while (reader.remaining() >= static_cast<size_t>(k) + 1) {
+			if (reader.read(1)) ++v;
+			const size_t x = reader.read(k);
+			if (x > v) v = x;
+			else if (v < static_cast<size_t>(n)) graph.add_edge(static_cast<int>(x), static_cast<int>(v));
+		}
+	}
+
+}
+
+
+std::string qe::to_graph6(const Graph& graph) {
+	std::string str;
+	append_graph6(str, graph);
+	return str;
+}
+
+std::string qe::to_sparse6(const Graph& graph) {
+	std::string str;
+	append_sparse6(str, graph);
+	return str;
+}
+
+Graph qe::from_graph6(std::string_view str) {
+	Graph graph{ 0 };
+	parse_graph6(str, graph);
+	return graph;
+}
+
+Graph qe::from_sparse6(std::string_view str) {
+	Graph graph{ 0 };
+	parse_sparse6(str, graph);
+	return graph;
+}
+
+
+bool GraphReader::read(Graph& graph) {
+	while (std::getline(stream, line)) {
+		++line_number_;
+		std::string_view str{ line };
+		if (!str.empty() && str.back() == '\r') str.remove_suffix(1);
+		if (str.starts_with(graph6_header)) str.remove_prefix(graph6_header.size());
+		else if (str.starts_with(sparse6_header)) str.remove_prefix(sparse6_header.size());
+		if (str.empty()) continue;
+		try {
+			if (str[0] == ':') parse_sparse6(str, graph);
+			else if (str[0] == ';') throw Graph_format_error{ "Incremental sparse6 is not supported" };
+			else parse_graph6(str, graph);
+		}
+		catch (const Graph_format_error& error) {
+			throw Graph_format_error{ std::string{ error.what() } + " (line " + std::to_string(line_number_) + ")" };
+		}
+		return true;
+	}
+	return false;
+}
+
+std::optional<Graph> GraphReader::next() {
+	Graph graph{ 0 };
+	if (!read(graph)) return std::nullopt;
+	return graph;
+}
+
+
+GraphWriter::GraphWriter(std::ostream& stream, GraphFormat format, bool header) : stream(stream), format(format) {
+	if (header) stream << (format == GraphFormat::graph6 ? graph6_header : sparse6_header);
+}
+
+void GraphWriter::write(const Graph& graph) {
+	buffer.clear();
+	if (format == GraphFormat::graph6) append_graph6(buffer, graph);
+	else append_sparse6(buffer, graph);
+	buffer.push_back('\n');
+	stream << buffer;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "graph.h"
+#include <iosfwd>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+namespace qe {
+
+	/// @brief Thrown when a line is not a valid graph6 or sparse6 string.
+	struct Graph_format_error : public std::runtime_error { using std::runtime_error::runtime_error; };
+
+	enum class GraphFormat { graph6, sparse6 };
+
+
+	/// @brief Encode a graph in the graph6 format of nauty (the upper triangle of the adjacency
+	///    matrix column by column, six bits per printable character). Suited for dense graphs.
+	std::string to_graph6(const Graph& graph);
+
+	/// @brief Encode a graph in the sparse6 format of nauty (a list of edges, ordered by their
+	///    larger vertex, with about log2(n) bits per edge). Suited for sparse graphs.
+	std::string to_sparse6(const Graph& graph);
+
+	/// @brief Decode a graph6 string without trailing line break.
+	/// @throws Graph_format_error
+	Graph from_graph6(std::string_view str);
+
+	/// @brief Decode a sparse6 string (starting with ':') without trailing line break.
+	/// @throws Graph_format_error
+	Graph from_sparse6(std::string_view str);
+
+
+	/// @brief Read graphs from a stream with one graph6 or sparse6 string per line, as written
+	///    by nauty's geng or GraphWriter.
+	///
+	/// Graphs are decoded one at a time while reading, so files of any size can be processed.
+	/// The format is detected per line, optional >>graph6<< and >>sparse6<< headers as well as
+	/// empty lines are skipped.
+	class GraphReader {
+	public:
+		explicit GraphReader(std::istream& stream) : stream(stream) {}
+
+		/// @brief Read the next graph into the given graph. Its storage is reused if the number
+		///    of vertices does not change, so reading many graphs of the same size does not
+		///    allocate.
+		/// @return False at the end of the stream.
+		/// @throws Graph_format_error
+		bool read(Graph& graph);
+
+		/// @brief Read the next graph or return std::nullopt at the end of the stream.
+		/// @throws Graph_format_error
+		std::optional<Graph> next();
+
+		/// @brief Number of lines consumed so far.
+		size_t line_number() const { return line_number_; }
+
+	private:
+		std::istream& stream;
+		std::string line;
+		size_t line_number_{};
+	};
+
+
+	/// @brief Write graphs to a stream, one graph6 or sparse6 string per line.
+	class GraphWriter {
+	public:
+		/// @param header If true, the file starts with >>graph6<< or >>sparse6<<.
+		explicit GraphWriter(std::ostream& stream, GraphFormat format = GraphFormat::graph6, bool header = false);
+
+		void write(const Graph& graph);
+
+	private:
+		std::ostream& stream;
+		GraphFormat format;
+		std::string buffer;
+	};
+
+}
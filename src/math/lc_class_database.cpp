@@ -0,0 +1,203 @@
+#include "lc_class_database.h"
+#include "canonical_labeling.h"
+#include "lc_orbit.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace qe;
+
+namespace {
+
+	constexpr char magic[8] = { 'Q', 'E', 'L', 'C', 'D', 'B', '0', '1' };
+	constexpr uint32_t byte_order_mark = 0x01020304;
+
+	using Header = LcClassDatabase::Header;
+	using GraphEntry = LcClassDatabase::GraphEntry;
+	using ClassEntry = LcClassDatabase::ClassEntry;
+
+	// The tables are accessed in place, so the layout must not depend on the compiler and
+	// each table must start at an 8-byte aligned offset.
+	static_assert(sizeof(Header) == 32 && std::is_trivially_copyable_v<Header>);
+	static_assert(sizeof(GraphEntry) == 16 && std::is_trivially_copyable_v<GraphEntry>);
+	static_assert(sizeof(ClassEntry) == 24 && std::is_trivially_copyable_v<ClassEntry>);
+
+
+	/// All non-isomorphic graphs with n vertices as sorted canonical codes. Every graph with
+	/// m + 1 edges arises from one with m edges by adding an edge, so the classes are found
+	/// level by level.
+	std::vector<uint64_t> isomorphism_classes(int n) {
+		std::vector<uint64_t> level{ 0 };
+		std::vector<uint64_t> result{ 0 };
+		std::unordered_set<uint64_t> next;
+		while (!level.empty()) {
+			next.clear();
+			for (const uint64_t code : level) {
+				auto graph = Graph::decompress(n, code);
+				for (int i = 0; i < n - 1; ++i) {
+					for (int j = i + 1; j < n; ++j) {
+						if (graph.has_edge(i, j)) continue;
+						graph.add_edge(i, j);
+						next.insert(canonical_code(graph));
+						graph.remove_edge(i, j);
+					}
+				}
+			}
+			level.assign(next.begin(), next.end());
+			result.insert(result.end(), level.begin(), level.end());
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	/// Whether the graph a has fewer edges than b or the same number and a smaller code.
+	bool is_better_representative(uint64_t a, uint64_t b) {
+		const int edges_a = std::popcount(a);
+		const int edges_b = std::popcount(b);
+		return edges_a < edges_b || (edges_a == edges_b && a < b);
+	}
+
+	template<class T>
+	void write_table(std::ofstream& stream, const std::vector<T>& table) {
+		stream.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(T)));
+	}
+
+}
+
+
+void qe::write_lc_class_database(const std::filesystem::path& path, int max_vertices, Q::ThreadPool* pool) {
+	assert(max_vertices >= 1 && max_vertices <= 10 && "LC class databases are only supported for up to 10 vertices");
+	std::vector<GraphEntry> graphs;
+	std::vector<ClassEntry> classes;
+
+	for (int n = 1; n <= max_vertices; ++n) {
+		const auto codes = isomorphism_classes(n);
+		std::unordered_map<uint64_t, uint32_t> class_of;
+		class_of.reserve(codes.size());
+
+		// Codes are visited in ascending order, so class ids are ordered by their smallest member.
+		for (const uint64_t start : codes) {
+			if (class_of.contains(start)) continue;
+			const auto class_id = static_cast<uint32_t>(classes.size());
+			ClassEntry entry{ .representative = start, .orbit_size = 0, .num_members = 0, .num_vertices = static_cast<uint32_t>(n) };
+			std::vector<uint64_t> queue{ start };
+			class_of.emplace(start, class_id);
+			while (!queue.empty()) {
+				const uint64_t code = queue.back();
+				queue.pop_back();
+				++entry.num_members;
+				if (is_better_representative(code, entry.representative)) entry.representative = code;
+				auto graph = Graph::decompress(n, code);
+				for (int v = 0; v < n; ++v) {
+					graph.local_complementation(v);
+					const uint64_t neighbour = canonical_code(graph);
+					if (class_of.emplace(neighbour, class_id).second) queue.push_back(neighbour);
+					graph.local_complementation(v);
+				}
+			}
+			classes.push_back(entry);
+		}
+		for (const uint64_t code : codes) {
+			graphs.push_back(GraphEntry{ .code = code, .num_vertices = static_cast<uint32_t>(n), .class_id = class_of.at(code) });
+		}
+	}
+
+	// The orbit size is the same for all members of a class since isomorphic graphs have
+	// isomorphic orbits.
+	auto compute_orbit_sizes = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const auto representative = Graph::decompress(classes[i].num_vertices, classes[i].representative);
+			classes[i].orbit_size = lc_orbit(representative, { .collect_members = false }).size;
+		}
+	};
+	if (pool) pool->parallel_for(classes.size(), compute_orbit_sizes);
+	else compute_orbit_sizes(0, classes.size());
+
+	Header header{};
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.byte_order = byte_order_mark;
+	header.max_vertices = static_cast<uint32_t>(max_vertices);
+	header.num_graphs = graphs.size();
+	header.num_classes = classes.size();
+
+	// Truncating the target in place would invalidate existing mappings of it (SIGBUS on
+	// access), while a rename leaves them pointing to the old file.
+	auto temporary = path;
+	temporary += ".tmp" + std::to_string(std::random_device{}());
+	{
+		std::ofstream stream{ temporary, std::ios::binary | std::ios::trunc };
+		if (!stream) throw std::runtime_error{ "Cannot open " + temporary.string() + " for writing" };
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		write_table(stream, graphs);
+		write_table(stream, classes);
+		stream.close();
+		if (!stream) {
+			std::filesystem::remove(temporary);
+			throw std::runtime_error{ "Failed to write " + temporary.string() };
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	if (error) {
+		std::filesystem::remove(temporary);
+		throw std::runtime_error{ "Cannot replace " + path.string() + ": " + error.message() };
+	}
+}
+
+
+qe::LcClassDatabase::LcClassDatabase(const std::filesystem::path& path) : file(path) {
+	if (file.size() < sizeof(Header)) throw Database_format_error{ "File is too small for an LC class database" };
+	header = reinterpret_cast<const Header*>(file.data());
+	if (std::memcmp(header->magic, magic, sizeof(magic)) != 0) throw Database_format_error{ "File is not an LC class database" };
+	if (header->byte_order != byte_order_mark) throw Database_format_error{ "LC class database has a different byte order" };
+	// The counts are bounded by the file size before multiplying, so a crafted header cannot
+	// overflow the size computation.
+	const size_t table_bytes = file.size() - sizeof(Header);
+	if (header->num_graphs > table_bytes / sizeof(GraphEntry)) throw Database_format_error{ "LC class database is truncated" };
+	const size_t class_bytes = table_bytes - header->num_graphs * sizeof(GraphEntry);
+	if (header->num_classes > class_bytes / sizeof(ClassEntry)) throw Database_format_error{ "LC class database is truncated" };
+	if (class_bytes != header->num_classes * sizeof(ClassEntry)) throw Database_format_error{ "LC class database has trailing data" };
+
+	const auto* graph_table = reinterpret_cast<const GraphEntry*>(file.data() + sizeof(Header));
+	graphs = { graph_table, header->num_graphs };
+	classes = { reinterpret_cast<const ClassEntry*>(graph_table + header->num_graphs), header->num_classes };
+}
+
+int qe::LcClassDatabase::max_vertices() const {
+	return static_cast<int>(header->max_vertices);
+}
+
+std::optional<LcClassInfo> qe::LcClassDatabase::find(const Graph& graph) const {
+	if (graph.num_vertices() < 1 || graph.num_vertices() > max_vertices()) return std::nullopt;
+	return find_canonical(graph.num_vertices(), canonical_code(graph));
+}
+
+std::optional<LcClassInfo> qe::LcClassDatabase::find_canonical(int num_vertices, uint64_t code) const {
+	const GraphEntry key{ .code = code, .num_vertices = static_cast<uint32_t>(num_vertices), .class_id = 0 };
+	auto less = [](const GraphEntry& a, const GraphEntry& b) {
+		return a.num_vertices < b.num_vertices || (a.num_vertices == b.num_vertices && a.code < b.code);
+	};
+	const auto it = std::lower_bound(graphs.begin(), graphs.end(), key, less);
+	if (it == graphs.end() || it->num_vertices != key.num_vertices || it->code != code) return std::nullopt;
+	// Checked here rather than when opening the file, which would touch every page of the table.
+	if (it->class_id >= classes.size()) throw Database_format_error{ "LC class database contains an invalid class id" };
+	return class_info(it->class_id);
+}
+
+LcClassInfo qe::LcClassDatabase::class_info(uint32_t class_id) const {
+	assert(class_id < classes.size() && "Class id out of range");
+	const auto& entry = classes[class_id];
+	return LcClassInfo{
+		.class_id = class_id,
+		.num_vertices = static_cast<int>(entry.num_vertices),
+		.num_members = entry.num_members,
+		.orbit_size = entry.orbit_size,
+		.representative = entry.representative,
+	};
+}
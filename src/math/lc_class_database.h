@@ -0,0 +1,120 @@
+#pragma once
+
+#include "graph.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+namespace Q {
+	class ThreadPool;
+}
+
+
+namespace qe {
+
+	/// @brief Thrown when a file is not a valid LC class database.
+	struct Database_format_error : public std::runtime_error { using std::runtime_error::runtime_error; };
+
+
+	/// @brief Information about the class of graphs that are equivalent under local
+	///    complementation and graph isomorphism.
+	struct LcClassInfo {
+		/// @brief Index of the class, in order of the number of vertices and then of the smallest
+		///    canonical code among the members.
+		uint32_t class_id{};
+		/// @brief Number of vertices of all graphs in the class.
+		int num_vertices{};
+		/// @brief Number of non-isomorphic graphs in the class.
+		uint32_t num_members{};
+		/// @brief Size of the (labeled) LC orbit of any graph in the class, see lc_orbit().
+		uint64_t orbit_size{};
+		/// @brief Canonical code (see canonical_code()) of the member with the fewest edges. Ties
+		///    are broken by the smaller code.
+		uint64_t representative{};
+
+		Graph representative_graph() const { return Graph::decompress(num_vertices, representative); }
+	};
+
+
+	/// @brief Classify all non-isomorphic graphs with 1 to max_vertices vertices into LC classes
+	///    and write the result as a database file that can be opened with LcClassDatabase.
+	///
+	/// For each vertex count, the isomorphism classes are enumerated level by level in the number
+	/// of edges by adding single edges and canonicalizing. The LC classes are then found with a
+	/// breadth-first search over canonical codes. All graphs of one vertex count are held in
+	/// memory, which limits the generator to max_vertices <= 10 (about 12.0 million graphs for
+	/// n = 10). With n = 11 there are about 1.02 billion graphs, i.e. 16 GB of table entries
+	/// alone, and 64-bit canonical codes end there anyway (about 165 billion graphs for n = 12).
+	/// Large databases should therefore be generated once and shipped.
+	///
+	/// The file is written to a temporary sibling and then renamed over the target, so
+	/// processes that still map an older version of the database keep a valid mapping.
+	/// @param pool If given, the orbit sizes of the classes are computed in parallel.
+	/// @throws std::runtime_error if the file cannot be written.
+	void write_lc_class_database(const std::filesystem::path& path, int max_vertices, Q::ThreadPool* pool = nullptr);
+
+
+	/// @brief Read-only view of a database file written by write_lc_class_database().
+	///
+	/// The file is memory-mapped and consists of a header, a table of all non-isomorphic graphs
+	/// sorted by vertex count and canonical code, and a table with one entry per LC class. A
+	/// lookup canonicalizes the graph and performs a binary search over the mapped table, so it
+	/// takes O(log N) time and the database is never copied into the heap. The file uses the
+	/// native byte order, which is verified when it is opened.
+	class LcClassDatabase {
+	public:
+		/// @throws std::system_error if the file cannot be mapped.
+		/// @throws Database_format_error if the file is not a valid database.
+		explicit LcClassDatabase(const std::filesystem::path& path);
+
+		/// @brief Largest vertex count contained in the database.
+		int max_vertices() const;
+		/// @brief Number of non-isomorphic graphs in the database.
+		size_t num_graphs() const { return graphs.size(); }
+		size_t num_classes() const { return classes.size(); }
+
+		/// @brief Look up the LC class of a graph. Returns std::nullopt if the number of vertices
+		///    is not covered by the database.
+		/// @throws Database_format_error if the entry of the graph refers to a nonexistent class.
+		std::optional<LcClassInfo> find(const Graph& graph) const;
+
+		/// @brief Look up the LC class of a graph given by its canonical code (see canonical_code()).
+		/// @throws Database_format_error if the entry of the graph refers to a nonexistent class.
+		std::optional<LcClassInfo> find_canonical(int num_vertices, uint64_t code) const;
+
+		/// @brief Get the class with the given index (< num_classes()).
+		LcClassInfo class_info(uint32_t class_id) const;
+
+
+		struct Header {
+			char magic[8];
+			uint32_t byte_order;
+			uint32_t max_vertices;
+			uint64_t num_graphs;
+			uint64_t num_classes;
+		};
+
+		struct GraphEntry {
+			uint64_t code;
+			uint32_t num_vertices;
+			uint32_t class_id;
+		};
+
+		struct ClassEntry {
+			uint64_t representative;
+			uint64_t orbit_size;
+			uint32_t num_members;
+			uint32_t num_vertices;
+		};
+
+	private:
+		Q::MappedFile file;
+		const Header* header{};
+		std::span<const GraphEntry> graphs;
+		std::span<const ClassEntry> classes;
+	};
+
+}
@@ -0,0 +1,171 @@
+#include "lc_equivalence.h"
+#include "binary_linear_algebra.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace qe;
+
+namespace {
+
+	using word_type = BitMatrix::word_type;
+
+
+	Graph induced_subgraph(const Graph& graph, const std::vector<int>& vertices) {
+		const int n = static_cast<int>(vertices.size());
+		Graph subgraph{ n };
+		for (int i = 0; i < n; ++i) {
+			for (int j = i + 1; j < n; ++j) {
+				if (graph.has_edge(vertices[i], vertices[j])) subgraph.add_edge(i, j);
+			}
+		}
+		return subgraph;
+	}
+
+
+	/// Linear system H A + H B G + C + D G = 0 with one row per entry (j, k) and the unknowns
+	/// ordered as a_0..a_{n-1}, b_0..b_{n-1}, c_0..c_{n-1}, d_0..d_{n-1}.
+	BitMatrix equations(const Graph& g, const Graph& h) {
+		const int n = g.num_vertices();
+		BitMatrix system(n * n, 4 * n);
+		for (int j = 0; j < n; ++j) {
+			for (int k = 0; k < n; ++k) {
+				const int row = j * n + k;
+				if (h.has_edge(j, k)) system.set(row, k);
+				for (int i = 0; i < n; ++i) {
+					if (h.has_edge(j, i) && g.has_edge(i, k)) system.set(row, n + i);
+				}
+				if (j == k) system.set(row, 2 * n + j);
+				if (g.has_edge(j, k)) system.set(row, 3 * n + j);
+			}
+		}
+		return system;
+	}
+
+	bool get_bit(const std::vector<word_type>& x, int i) { return (x[i / 64] >> (i % 64)) & 1; }
+
+	/// Whether the solution x satisfies a_v d_v + b_v c_v = 1 for every vertex.
+	bool is_symplectic(const std::vector<word_type>& x, int n) {
+		for (int v = 0; v < n; ++v) {
+			const bool ad = get_bit(x, v) && get_bit(x, 3 * n + v);
+			const bool bc = get_bit(x, n + v) && get_bit(x, 2 * n + v);
+			if (ad == bc) return false;
+		}
+		return true;
+	}
+
+	std::vector<LocalClifford> to_local_cliffords(const std::vector<word_type>& x, int n) {
+		std::vector<LocalClifford> cliffords(n);
+		for (int v = 0; v < n; ++v) {
+			cliffords[v] = LocalClifford{ get_bit(x, v), get_bit(x, n + v), get_bit(x, 2 * n + v), get_bit(x, 3 * n + v) };
+		}
+		return cliffords;
+	}
+
+	/// Local Cliffords mapping the connected graph g to h or std::nullopt.
+	std::optional<std::vector<LocalClifford>> solve_component(const Graph& g, const Graph& h) {
+		const int n = g.num_vertices();
+		const auto basis = nullspace(equations(g, h));
+		const int dimension = static_cast<int>(basis.rows());
+		const auto words = basis.words_per_row();
+
+		auto row = [&](int i) { return std::vector<word_type>(basis.row(i).begin(), basis.row(i).end()); };
+		auto add_row = [&](std::vector<word_type>& x, int i) {
+			for (size_t w = 0; w < words; ++w) x[w] ^= basis.row(i)[w];
+		};
+
+		if (dimension <= 4) {
+			for (int mask = 1; mask < (1 << dimension); ++mask) {
+				std::vector<word_type> x(words);
+				for (int i = 0; i < dimension; ++i) {
+					if (mask >> i & 1) add_row(x, i);
+				}
+				if (is_symplectic(x, n)) return to_local_cliffords(x, n);
+			}
+			return std::nullopt;
+		}
+		for (int i = 0; i < dimension; ++i) {
+			auto x = row(i);
+			if (is_symplectic(x, n)) return to_local_cliffords(x, n);
+			for (int j = i + 1; j < dimension; ++j) {
+				add_row(x, j);
+				if (is_symplectic(x, n)) return to_local_cliffords(x, n);
+				add_row(x, j);
+			}
+		}
+		return std::nullopt;
+	}
+
+
+	/// Replacing the graph by its local complement at v right-multiplies the local Clifford
+	/// of v by [[1, 1], [0, 1]] and the ones of the neighbours of v by [[1, 0], [1, 1]].
+	void local_complementation(Graph& graph, std::vector<LocalClifford>& cliffords, int v, std::vector<int>& sequence) {
+		for (int w = 0; w < graph.num_vertices(); ++w) {
+			if (!graph.has_edge(v, w)) continue;
+			auto& q = cliffords[w];
+			q.a += q.b;
+			q.c += q.d;
+		}
+		auto& q = cliffords[v];
+		q.b += q.a;
+		q.d += q.c;
+		graph.local_complementation(v);
+		sequence.push_back(v);
+	}
+
+	/// Apply local complementations until all b_v vanish. A vertex with a_v = b_v = 1 loses b_v
+	/// without changing the other b's. For a_v = 0 and b_v = 1, the diagonal equation at v
+	/// (with c_v = 1) guarantees a neighbour u with b_u = 1 and, if the first case does not apply,
+	/// a_u = 0. The pivot on the edge uv swaps the columns of both local Cliffords and thus clears
+	/// b_u and b_v. Afterwards the equations force A = D = 1 and C = 0, so the graph has become
+	/// the target.
+	std::vector<int> lc_sequence(Graph graph, std::vector<LocalClifford> cliffords) {
+		const int n = graph.num_vertices();
+		std::vector<int> sequence;
+		while (true) {
+			auto v = std::find_if(cliffords.begin(), cliffords.end(), [](const LocalClifford& q) { return q.a == 1 && q.b == 1; });
+			if (v != cliffords.end()) {
+				local_complementation(graph, cliffords, static_cast<int>(v - cliffords.begin()), sequence);
+				continue;
+			}
+			v = std::find_if(cliffords.begin(), cliffords.end(), [](const LocalClifford& q) { return q.b == 1; });
+			if (v == cliffords.end()) break;
+			const int vertex = static_cast<int>(v - cliffords.begin());
+			int neighbour = 0;
+			while (neighbour < n && !(graph.has_edge(vertex, neighbour) && cliffords[neighbour].b == 1)) ++neighbour;
+			assert(neighbour < n && "Vertex with a = 0 and b = 1 needs a neighbour with b = 1");
+			local_complementation(graph, cliffords, vertex, sequence);
+			local_complementation(graph, cliffords, neighbour, sequence);
+			local_complementation(graph, cliffords, vertex, sequence);
+		}
+		return sequence;
+	}
+
+}
+
+
+std::optional<LcEquivalence> qe::lc_equivalence(const Graph& graph1, const Graph& graph2) {
+	const int n = graph1.num_vertices();
+	if (graph2.num_vertices() != n) return std::nullopt;
+	std::vector<int> labels1(n);
+	std::vector<int> labels2(n);
+	const int num_components = graph1.connected_components(labels1);
+	graph2.connected_components(labels2);
+	if (labels1 != labels2) return std::nullopt;
+	std::vector<std::vector<int>> parts(num_components);
+	for (int v = 0; v < n; ++v) parts[labels1[v]].push_back(v);
+
+	LcEquivalence result{ .local_cliffords = std::vector<LocalClifford>(n), .sequence = {} };
+	for (const auto& part : parts) {
+		if (part.size() == 1) continue;
+		const auto g = induced_subgraph(graph1, part);
+		const auto cliffords = solve_component(g, induced_subgraph(graph2, part));
+		if (!cliffords) return std::nullopt;
+		for (size_t i = 0; i < part.size(); ++i) result.local_cliffords[part[i]] = (*cliffords)[i];
+		for (int v : lc_sequence(g, *cliffords)) result.sequence.push_back(part[v]);
+	}
+	return result;
+}
+
+bool qe::is_lc_equivalent(const Graph& graph1, const Graph& graph2) {
+	return lc_equivalence(graph1, graph2).has_value();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "graph.h"
+#include "binary.h"
+#include <optional>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Single-qubit Clifford up to Pauli operators, given by its symplectic matrix
+	///    [[a, b], [c, d]] that maps the (x, z) exponents of a Pauli X^x Z^z to (ax + bz, cx + dz).
+	struct LocalClifford {
+		Binary a{ 1 };
+		Binary b{};
+		Binary c{};
+		Binary d{ 1 };
+
+		friend bool operator==(const LocalClifford&, const LocalClifford&) = default;
+	};
+
+
+	/// @brief Witness for the local Clifford equivalence of two graph states.
+	struct LcEquivalence {
+		/// @brief Local Clifford of each vertex such that their tensor product maps the graph
+		///    state of the first graph to the one of the second graph (up to Paulis).
+		std::vector<LocalClifford> local_cliffords;
+		/// @brief Vertices at which to apply local complementations to the first graph (in this
+		///    order) in order to obtain the second graph.
+		std::vector<int> sequence;
+	};
+
+
+	/// @brief Decide whether two graph states are equivalent under local Clifford operations
+	///    in polynomial time with the algorithm of Bouchet, as formulated by Van den Nest,
+	///    Dehaene and De Moor, "Efficient algorithm to recognize the local Clifford
+	///    equivalence of graph states" (2004).
+	///
+	/// A local Clifford with symplectic blocks A, B, C, D (diagonal n x n matrices) maps the graph
+	/// with adjacency matrix G to the one with adjacency matrix H if and only if
+	/// H A + H B G + C + D G = 0 and a_v d_v + b_v c_v = 1 for every vertex v. The first condition
+	/// is a linear system of n^2 equations in 4n unknowns that is solved over F2 with packed
+	/// rows. If the solution space of a connected component has dimension at most 4, all its
+	/// elements are tested, otherwise a valid solution exists if and only if one of the basis
+	/// vectors or the sum of two basis vectors is one. Since local complementations never merge
+	/// or split components, the components are treated separately. The vertex sequence is
+	/// obtained by applying local complementations and pivots until the remaining local
+	/// Clifford is the identity, which takes at most 3n/2 steps.
+	/// @return The local Cliffords and the local complementation sequence if the graphs are
+	///    equivalent and std::nullopt otherwise.
+	std::optional<LcEquivalence> lc_equivalence(const Graph& graph1, const Graph& graph2);
+
+	/// @brief Check whether two graph states are equivalent under local Clifford operations
+	///    (see lc_equivalence()).
+	bool is_lc_equivalent(const Graph& graph1, const Graph& graph2);
+
+}
@@ -0,0 +1,86 @@
+#include "lc_orbit.h"
+#include "concurrent_hash_set.h"
+#include "thread_pool.h"
+#include "tracked_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace qe;
+
+
+LcOrbit qe::lc_orbit(const Graph& graph, const LcOrbitOptions& options) {
+	const int n = graph.num_vertices();
+	const uint64_t start = Graph::compress(graph);
+
+	Q::ConcurrentHashSet visited;
+	visited.insert(start);
+	std::atomic<bool> stop{ false };
+	std::optional<uint64_t> match;
+	std::mutex mutex;
+
+	auto report_match = [&](uint64_t code) {
+		std::lock_guard lock{ mutex };
+		if (!match) match = code;
+		stop = true;
+	};
+	if (options.stop_predicate && options.stop_predicate(graph)) report_match(start);
+
+	std::vector<uint64_t> frontier{ start };
+	std::vector<uint64_t> next;
+
+	// Expands the frontier entries [begin, end). Since local complementation is an involution,
+	// each neighbour is visited by applying it and then undoing it on the same graph. The code
+	// is updated along with the local complementation instead of compressing the whole graph.
+	auto expand = [&](size_t begin, size_t end) {
+		std::vector<uint64_t> found;
+		for (size_t k = begin; k < end && !stop.load(std::memory_order_relaxed); ++k) {
+			TrackedGraph current{ Graph::decompress(n, frontier[k]) };
+			for (int v = 0; v < n; ++v) {
+				current.local_complementation(v);
+				const uint64_t code = current.code();
+				if (visited.insert(code)) {
+					found.push_back(code);
+					if (options.stop_predicate && options.stop_predicate(current.graph())) report_match(code);
+					if (visited.size() >= options.max_size) stop = true;
+				}
+				current.local_complementation(v);
+			}
+		}
+		std::lock_guard lock{ mutex };
+		next.insert(next.end(), found.begin(), found.end());
+	};
+
+	while (!frontier.empty() && !stop && visited.size() < options.max_size) {
+		visited.reserve(visited.size() + frontier.size() * n);
+		if (options.pool) options.pool->parallel_for(frontier.size(), expand, 64);
+		else expand(0, frontier.size());
+		// Keep the possibly partially expanded level for the completeness check below.
+		if (stop) break;
+		frontier.swap(next);
+		next.clear();
+	}
+
+	// All members of earlier levels have been expanded completely. If the size limit was
+	// reached, the orbit may still have been enumerated completely, which is the case if no
+	// member of the last two levels has an unvisited neighbour.
+	auto has_unvisited_neighbour = [&](uint64_t code) {
+		TrackedGraph current{ Graph::decompress(n, code) };
+		for (int v = 0; v < n; ++v) {
+			current.local_complementation(v);
+			if (!visited.contains(current.code())) return true;
+			current.local_complementation(v);
+		}
+		return false;
+	};
+	LcOrbit result;
+	result.size = visited.size();
+	result.complete = !match
+		&& std::none_of(frontier.begin(), frontier.end(), has_unvisited_neighbour)
+		&& std::none_of(next.begin(), next.end(), has_unvisited_neighbour);
+	result.match = match;
+	auto members = visited.values();
+	result.representative = *std::min_element(members.begin(), members.end());
+	if (options.collect_members) result.members = std::move(members);
+	return result;
+}
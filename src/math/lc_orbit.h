@@ -0,0 +1,53 @@
+#pragma once
+
+#include "graph.h"
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Q {
+	class ThreadPool;
+}
+
+
+namespace qe {
+
+	struct LcOrbitOptions {
+		/// @brief If given, each BFS level is expanded in parallel on the pool's threads.
+		Q::ThreadPool* pool{};
+		/// @brief If set, the search stops as soon as a graph in the orbit satisfies the predicate.
+		///    It may be called concurrently from several threads.
+		std::function<bool(const Graph&)> stop_predicate{};
+		/// @brief The search stops after this many distinct graphs have been found. With several
+		///    threads, a few more graphs may be found before all of them have stopped.
+		size_t max_size{ std::numeric_limits<size_t>::max() };
+		/// @brief Whether to return the codes of all members of the orbit.
+		bool collect_members{ true };
+	};
+
+	struct LcOrbit {
+		/// @brief Number of distinct graphs found.
+		size_t size{};
+		/// @brief Smallest compressed code among the members, identical for all graphs of the orbit
+		///    if the orbit is complete.
+		uint64_t representative{};
+		/// @brief Compressed codes of the members (see Graph::compress) in unspecified order.
+		std::vector<uint64_t> members;
+		/// @brief Code of the graph that satisfied the stop predicate, if any.
+		std::optional<uint64_t> match;
+		/// @brief False if the search was stopped by the predicate or if max_size was reached
+		///    before all members were found. An orbit with exactly max_size members is complete.
+		bool complete{};
+	};
+
+
+	/// @brief Enumerate all graphs reachable from the given graph by sequences of local
+	///    complementations with a level-synchronous breadth-first search.
+	///
+	/// Graphs are identified by their compressed codes which are deduplicated in a lock-free
+	/// hash set. Before each level, the set is resized to fit all possible new members, so
+	/// insertion never has to wait for a rehash. Requires n <= 11 so that codes fit into 64 bits.
+	LcOrbit lc_orbit(const Graph& graph, const LcOrbitOptions& options = {});
+
+}
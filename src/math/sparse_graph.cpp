@@ -0,0 +1,128 @@
+#include "sparse_graph.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iterator>
+
+using namespace qe;
+
+
+SparseGraph::SparseGraph(const Graph& graph) : adjacency(graph.num_vertices()) {
+	const auto& matrix = graph.get_adjacency_matrix();
+	for (int i = 0; i < num_vertices(); ++i) {
+		const auto row = matrix.row(i);
+		for (size_t w = 0; w < row.size(); ++w) {
+			for (auto bits = row[w]; bits; bits &= bits - 1) {
+				adjacency[i].push_back(static_cast<int>(w * Graph::AdjacencyMatrix::word_bits) + std::countr_zero(bits));
+			}
+		}
+		num_edges += adjacency[i].size();
+	}
+	num_edges /= 2;
+}
+
+Graph SparseGraph::to_graph() const {
+	Graph graph{ num_vertices() };
+	for (int i = 0; i < num_vertices(); ++i) {
+		for (int j : adjacency[i]) graph.adjacency_matrix.set(i, j);
+	}
+	return graph;
+}
+
+SparseGraph SparseGraph::grid(int rows, int cols) {
+	SparseGraph graph{ rows * cols };
+	for (int r = 0; r < rows; ++r) {
+		for (int c = 0; c < cols; ++c) {
+			const int v = r * cols + c;
+			if (c + 1 < cols) graph.add_edge(v, v + 1);
+			if (r + 1 < rows) graph.add_edge(v, v + cols);
+		}
+	}
+	return graph;
+}
+
+bool SparseGraph::has_edge(int vertex1, int vertex2) const {
+	return std::binary_search(adjacency[vertex1].begin(), adjacency[vertex1].end(), vertex2);
+}
+
+void SparseGraph::add_edge(int vertex1, int vertex2) {
+	if (vertex1 == vertex2 || has_edge(vertex1, vertex2)) return;
+	toggle_edge(vertex1, vertex2);
+}
+
+void SparseGraph::remove_edge(int vertex1, int vertex2) {
+	if (!has_edge(vertex1, vertex2)) return;
+	toggle_edge(vertex1, vertex2);
+}
+
+void SparseGraph::toggle_edge(int vertex1, int vertex2) {
+	assert(vertex1 != vertex2 && "Graphs cannot have self-loops");
+	toggle_half_edge(vertex2, vertex1);
+	if (toggle_half_edge(vertex1, vertex2)) ++num_edges;
+	else --num_edges;
+}
+
+bool SparseGraph::toggle_half_edge(int vertex1, int vertex2) {
+	auto& list = adjacency[vertex1];
+	const auto it = std::lower_bound(list.begin(), list.end(), vertex2);
+	if (it != list.end() && *it == vertex2) {
+		list.erase(it);
+		return false;
+	}
+	list.insert(it, vertex2);
+	return true;
+}
+
+std::vector<std::pair<int, int>> SparseGraph::get_edges() const {
+	std::vector<std::pair<int, int>> edges;
+	edges.reserve(num_edges);
+	for (int i = 0; i < num_vertices(); ++i) {
+		for (auto it = std::upper_bound(adjacency[i].begin(), adjacency[i].end(), i); it != adjacency[i].end(); ++it) {
+			edges.emplace_back(i, *it);
+		}
+	}
+	return edges;
+}
+
+void SparseGraph::local_complementation(int vertex) {
+	const auto& neighbourhood = adjacency[vertex];
+	std::ptrdiff_t degree_change{};
+	for (const int a : neighbourhood) {
+		// N(a) becomes the symmetric difference of N(a) and N(vertex) \ {a}.
+		auto& list = adjacency[a];
+		buffer.clear();
+		std::set_symmetric_difference(list.begin(), list.end(), neighbourhood.begin(), neighbourhood.end(), std::back_inserter(buffer));
+		// a itself is in N(vertex) but never in N(a), so the difference contains it.
+		buffer.erase(std::lower_bound(buffer.begin(), buffer.end(), a));
+		degree_change += std::ssize(buffer) - std::ssize(list);
+		list.swap(buffer);
+	}
+	// Every toggled edge between two neighbours was counted from both sides.
+	num_edges += degree_change / 2;
+}
+
+std::vector<std::vector<int>> SparseGraph::connected_components(bool sort_by_size) const {
+	std::vector<std::vector<int>> components;
+	std::vector<bool> visited(num_vertices());
+	for (int root = 0; root < num_vertices(); ++root) {
+		if (visited[root]) continue;
+		visited[root] = true;
+		std::vector<int> component{ root };
+		for (size_t i = 0; i < component.size(); ++i) {
+			for (const int w : adjacency[component[i]]) {
+				if (!visited[w]) {
+					visited[w] = true;
+					component.push_back(w);
+				}
+			}
+		}
+		std::sort(component.begin(), component.end());
+		components.push_back(std::move(component));
+	}
+	if (sort_by_size) {
+		std::stable_sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
+			return a.size() < b.size();
+		});
+	}
+	return components;
+}
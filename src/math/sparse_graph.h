@@ -0,0 +1,73 @@
+#pragma once
+
+#include "graph.h"
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Graph stored as sorted adjacency lists, for graphs with many vertices and few
+	///    edges per vertex (e.g. cluster states on lattices with 10^4 to 10^5 qubits).
+	///
+	/// Memory is O(n + m) instead of the O(n^2) bits of Graph. Edge queries use binary search
+	/// and insertion or removal costs O(degree). A local complementation at v merges N(v) into
+	/// the sorted list of each neighbour, which takes O(deg(v)^2 + sum of the neighbour degrees)
+	/// and does not depend on n.
+	class SparseGraph {
+	public:
+		explicit SparseGraph(int num_vertices) : adjacency(num_vertices) {}
+
+		/// @brief Convert a dense graph.
+		explicit SparseGraph(const Graph& graph);
+
+		/// @brief Convert to a dense graph.
+		Graph to_graph() const;
+
+		/// @brief Square lattice with rows x cols vertices, where vertex r * cols + c is
+		///    connected to its horizontal and vertical neighbours.
+		static SparseGraph grid(int rows, int cols);
+
+
+		int num_vertices() const { return static_cast<int>(adjacency.size()); }
+		size_t edge_count() const { return num_edges; }
+
+		/// @brief Sorted neighbours of a vertex.
+		std::span<const int> neighbours(int vertex) const { return adjacency[vertex]; }
+		int degree(int vertex) const { return static_cast<int>(adjacency[vertex].size()); }
+
+		bool has_edge(int vertex1, int vertex2) const;
+
+		void add_edge(int vertex1, int vertex2);
+		void remove_edge(int vertex1, int vertex2);
+		void toggle_edge(int vertex1, int vertex2);
+
+		/// @brief Get all edges (i, j) with i < j, ordered by i and then j.
+		std::vector<std::pair<int, int>> get_edges() const;
+
+		/// @brief Complement the neighbourhood of a vertex.
+		void local_complementation(int vertex);
+
+		void local_complementation(std::span<const int> vertices) {
+			for (int vertex : vertices) local_complementation(vertex);
+		}
+
+		/// @brief Get the connected components with a breadth-first search in O(n + m). Each
+		///    component is sorted and the components are ordered by their smallest vertex.
+		/// @param sort_by_size If true, the components are sorted by size (smallest to largest).
+		std::vector<std::vector<int>> connected_components(bool sort_by_size = false) const;
+
+		friend bool operator==(const SparseGraph& g1, const SparseGraph& g2) { return g1.adjacency == g2.adjacency; }
+
+	private:
+		std::vector<std::vector<int>> adjacency;
+		size_t num_edges{};
+		/// Scratch space for merging adjacency lists.
+		std::vector<int> buffer;
+
+		/// Insert or remove vertex2 in the list of vertex1 and return whether it was inserted.
+		bool toggle_half_edge(int vertex1, int vertex2);
+	};
+
+}
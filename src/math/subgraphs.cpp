@@ -0,0 +1,212 @@
+#include "subgraphs.h"
+#include <bit>
+#include <cassert>
+#include <numeric>
+
+using namespace qe;
+
+namespace {
+
+	using mask_type = SubgraphRange::mask_type;
+
+	constexpr mask_type low_mask(int count) {
+		return count >= 64 ? ~mask_type{} : (mask_type{ 1 } << count) - 1;
+	}
+
+	/// Next larger mask with the same number of set bits (Gosper's hack). The mask must not be
+	/// the largest one with this number of bits below bit width.
+	constexpr mask_type next_combination(mask_type mask) {
+		const mask_type lowest = mask & (~mask + 1);
+		const mask_type ripple = mask + lowest;
+		return (((ripple ^ mask) >> 2) / lowest) | ripple;
+	}
+
+}
+
+
+SubgraphRange::SubgraphRange(const Graph& graph, int min_edges, int max_edges)
+	: num_vertices(graph.num_vertices()) {
+	for (int i = 0; i < num_vertices - 1; ++i) {
+		for (int j = i + 1; j < num_vertices; ++j) {
+			if (graph.has_edge(i, j)) edges_.emplace_back(i, j);
+		}
+	}
+	assert(edges_.size() <= 64 && "Subgraph enumeration is only supported for up to 64 edges");
+	if (num_vertices <= 11) {
+		for (const auto& [i, j] : edges_) edge_codes.push_back(uint64_t{ 1 } << (i * (2 * num_vertices - i - 1) / 2 + (j - i - 1)));
+	}
+	min_edges_ = std::max(min_edges, 0);
+	max_edges_ = std::min(max_edges, static_cast<int>(edges_.size()));
+}
+
+uint64_t SubgraphRange::size() const {
+	uint64_t count{};
+	for (int k = min_edges_; k <= max_edges_; ++k) {
+		const uint64_t summand = binomial(static_cast<int>(edges_.size()), k);
+		if (count > std::numeric_limits<uint64_t>::max() - summand) return std::numeric_limits<uint64_t>::max();
+		count += summand;
+	}
+	return count;
+}
+
+SubgraphRange::iterator SubgraphRange::at(int edge_count, uint64_t rank) const {
+	assert(edge_count >= min_edges_ && "Number of edges is outside of the range");
+	if (edge_count > max_edges_) return iterator{ *this, edge_count, 0 };
+	assert(rank < binomial(static_cast<int>(edges_.size()), edge_count) && "Rank is out of range");
+	return iterator{ *this, edge_count, unrank_combination(edge_count, rank) };
+}
+
+Graph SubgraphRange::subgraph(mask_type mask) const {
+	Graph graph{ num_vertices };
+	for (; mask; mask &= mask - 1) {
+		const auto& [i, j] = edges_[std::countr_zero(mask)];
+		graph.add_edge(i, j);
+	}
+	return graph;
+}
+
+std::vector<SubgraphRange::Chunk> SubgraphRange::split(uint64_t num_chunks, uint64_t min_chunk) const {
+	const uint64_t chunk_size = std::max({ size() / std::max<uint64_t>(num_chunks, 1), min_chunk, uint64_t{ 1 } });
+	std::vector<Chunk> chunks;
+	for (int k = min_edges_; k <= max_edges_; ++k) {
+		const uint64_t count = binomial(static_cast<int>(edges_.size()), k);
+		for (uint64_t rank = 0; rank < count; rank += std::min(chunk_size, count - rank)) {
+			chunks.push_back(Chunk{ .edge_count = k, .rank = rank, .size = std::min(chunk_size, count - rank) });
+		}
+	}
+	return chunks;
+}
+
+uint64_t SubgraphRange::binomial(int n, int k) {
+	if (k < 0 || k > n) return 0;
+	k = std::min(k, n - k);
+	uint64_t result{ 1 };
+	for (int i = 1; i <= k; ++i) {
+		// result * (n - k + i) / i is exact. After cancelling the gcd of result and i, the
+		// remaining divisor divides n - k + i.
+		const uint64_t g = std::gcd(result, static_cast<uint64_t>(i));
+		const uint64_t multiplier = static_cast<uint64_t>(n - k + i) / (i / g);
+		if (result / g > std::numeric_limits<uint64_t>::max() / multiplier) return std::numeric_limits<uint64_t>::max();
+		result = result / g * multiplier;
+	}
+	return result;
+}
+
+mask_type SubgraphRange::unrank_combination(int k, uint64_t rank) {
+	// The largest element c_k satisfies binomial(c_k, k) <= rank, then continue with the rest.
+	mask_type mask{};
+	int c = 64;
+	for (int i = k; i >= 1; --i) {
+		do --c;
+		while (binomial(c, i) > rank);
+		mask |= mask_type{ 1 } << c;
+		rank -= binomial(c, i);
+	}
+	return mask;
+}
+
+
+SubgraphRange::iterator::iterator(const SubgraphRange& range, int edge_count, mask_type mask)
+	: range(&range), graph(range.num_vertices), edge_count_(edge_count) {
+	if (edge_count > range.max_edges_) return;
+	done = false;
+	move_to(mask);
+}
+
+uint64_t SubgraphRange::iterator::code() const {
+	assert(range->num_vertices <= 11 && "Graph codes are only supported for up to 11 vertices");
+	return code_;
+}
+
+SubgraphRange::iterator& SubgraphRange::iterator::operator++() {
+	const int num_edges = static_cast<int>(range->edges_.size());
+	const mask_type last = edge_count_ == 0 ? 0 : low_mask(edge_count_) << (num_edges - edge_count_);
+	if (mask_ != last) {
+		move_to(next_combination(mask_));
+	}
+	else if (edge_count_ < range->max_edges_) {
+		++edge_count_;
+		move_to(low_mask(edge_count_));
+	}
+	else {
+		done = true;
+	}
+	return *this;
+}
+
+void SubgraphRange::iterator::move_to(mask_type mask) {
+	for (mask_type changed = mask ^ mask_; changed; changed &= changed - 1) {
+		const int e = std::countr_zero(changed);
+		const auto& [i, j] = range->edges_[e];
+		graph.toggle_edge(i, j);
+		if (!range->edge_codes.empty()) code_ ^= range->edge_codes[e];
+	}
+	mask_ = mask;
+}
+
+
+SubgraphWalk::SubgraphWalk(const Graph& graph)
+	: graph_(graph.num_vertices()), rows(graph.num_vertices()), degrees_(graph.num_vertices()), component_count_(graph.num_vertices()) {
+	const int n = graph.num_vertices();
+	assert(n <= 64 && "Subgraph walks are only supported for up to 64 vertices");
+	for (int i = 0; i < n - 1; ++i) {
+		for (int j = i + 1; j < n; ++j) {
+			if (graph.has_edge(i, j)) edges_.emplace_back(i, j);
+		}
+	}
+	assert(edges_.size() <= 64 && "Subgraph walks are only supported for up to 64 edges");
+	if (n <= 11) {
+		for (const auto& [i, j] : edges_) edge_codes.push_back(uint64_t{ 1 } << (i * (2 * n - i - 1) / 2 + (j - i - 1)));
+	}
+	last_step = low_mask(static_cast<int>(edges_.size()));
+}
+
+bool SubgraphWalk::next() {
+	if (step_ == last_step) return false;
+	++step_;
+	const int e = std::countr_zero(step_);
+	const auto [u, v] = edges_[e];
+	const mask_type bit_u = mask_type{ 1 } << u;
+	const mask_type bit_v = mask_type{ 1 } << v;
+	toggled_edge_ = e;
+	mask_ ^= mask_type{ 1 } << e;
+	graph_.toggle_edge(u, v);
+	if (!edge_codes.empty()) code_ ^= edge_codes[e];
+
+	if ((mask_ >> e) & 1) {
+		if (!connected(u, v)) --component_count_;
+		rows[u] |= bit_v;
+		rows[v] |= bit_u;
+		++degrees_[u];
+		++degrees_[v];
+		++edge_count_;
+	}
+	else {
+		rows[u] &= ~bit_v;
+		rows[v] &= ~bit_u;
+		if (!connected(u, v)) ++component_count_;
+		--degrees_[u];
+		--degrees_[v];
+		--edge_count_;
+	}
+	return true;
+}
+
+uint64_t SubgraphWalk::code() const {
+	assert(graph_.num_vertices() <= 11 && "Graph codes are only supported for up to 11 vertices");
+	return code_;
+}
+
+bool SubgraphWalk::connected(int u, int v) const {
+	const mask_type target = mask_type{ 1 } << v;
+	mask_type reached = mask_type{ 1 } << u;
+	mask_type frontier = reached;
+	while (frontier) {
+		mask_type neighbours{};
+		for (; frontier; frontier &= frontier - 1) neighbours |= rows[std::countr_zero(frontier)];
+		frontier = neighbours & ~reached;
+		if (frontier & target) return true;
+		reached |= frontier;
+	}
+	return false;
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "graph.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Lazy range over the subgraphs of a graph (same vertices, a subset of the edges)
+	///    whose number of edges lies in [min_edges, max_edges].
+	///
+	/// A subgraph is identified by a mask over the edges of the graph, where bit e stands for
+	/// edges()[e]. The masks are visited by increasing number of edges and, for each number of
+	/// edges k, in increasing order using Gosper's hack, so masks outside of the window are never
+	/// touched. The iterator owns a single Graph that is updated by toggling the edges in which
+	/// consecutive masks differ, so iterating does not allocate. Requires at most 64 edges.
+	class SubgraphRange {
+	public:
+		using mask_type = uint64_t;
+
+		class iterator {
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using value_type = Graph;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+
+			/// @brief The current subgraph. The reference is invalidated by incrementing.
+			const Graph& operator*() const { return graph; }
+			const Graph* operator->() const { return &graph; }
+
+			/// @brief Edge mask of the current subgraph.
+			mask_type mask() const { return mask_; }
+
+			/// @brief Graph::compress() of the current subgraph. Requires n <= 11.
+			uint64_t code() const;
+
+			/// @brief Number of edges of the current subgraph.
+			int edge_count() const { return edge_count_; }
+
+			iterator& operator++();
+			void operator++(int) { ++*this; }
+
+			friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.done; }
+
+		private:
+			friend class SubgraphRange;
+
+			const SubgraphRange* range{};
+			Graph graph{ 0 };
+			mask_type mask_{};
+			uint64_t code_{};
+			int edge_count_{};
+			bool done{ true };
+
+			iterator(const SubgraphRange& range, int edge_count, mask_type mask);
+			void move_to(mask_type mask);
+		};
+
+
+		SubgraphRange(const Graph& graph, int min_edges, int max_edges);
+
+		iterator begin() const { return at(min_edges_, 0); }
+		std::default_sentinel_t end() const { return {}; }
+
+		/// @brief Edges (i, j) with i < j of the graph in row-major order.
+		const std::vector<std::pair<int, int>>& edges() const { return edges_; }
+
+		int min_edges() const { return min_edges_; }
+		int max_edges() const { return max_edges_; }
+
+		/// @brief Number of subgraphs in the range (saturates at the maximum of uint64_t).
+		uint64_t size() const;
+
+		/// @brief Iterator to the subgraph with the given number of edges and rank among the
+		///    subgraphs with this number of edges. Iterating continues with the following subgraphs
+		///    of the range.
+		iterator at(int edge_count, uint64_t rank) const;
+
+		/// @brief Create the subgraph belonging to an edge mask.
+		Graph subgraph(mask_type mask) const;
+
+
+		/// @brief Consecutive subgraphs with the same number of edges.
+		struct Chunk {
+			int edge_count{};
+			/// @brief Rank of the first subgraph among all subgraphs with edge_count edges.
+			uint64_t rank{};
+			uint64_t size{};
+		};
+
+		/// @brief Split the range into chunks of roughly equal size (at least min_chunk
+		///    subgraphs, unless a size class is smaller) in iteration order.
+		std::vector<Chunk> split(uint64_t num_chunks, uint64_t min_chunk = 1) const;
+
+		/// @brief Number of k-element subsets of an n-element set (saturates at the maximum of uint64_t).
+		static uint64_t binomial(int n, int k);
+
+		/// @brief The mask with k set bits at position rank in increasing order, i.e. the
+		///    combination of the given rank in the combinatorial number system.
+		static mask_type unrank_combination(int k, uint64_t rank);
+
+	private:
+		int num_vertices{};
+		std::vector<std::pair<int, int>> edges_;
+		/// Bit of each edge in Graph::compress() (only for n <= 11).
+		std::vector<uint64_t> edge_codes;
+		int min_edges_{};
+		int max_edges_{};
+	};
+
+
+	/// @brief Walk over all 2^E edge subsets of a graph in reflected Gray-code order, starting
+	///    with the empty subgraph, while maintaining invariants incrementally.
+	///
+	/// Step s toggles the edge countr_zero(s), so consecutive subgraphs differ by a single
+	/// edge and the mask after step s is s ^ (s >> 1). Degrees, edge count and compressed code
+	/// are updated in constant time. The number of connected components only changes when an
+	/// inserted edge joins two components or a removed edge was a bridge, which is decided by a
+	/// bit-parallel search over the adjacency rows of the current subgraph. This costs one word
+	/// operation per reached vertex instead of a full connected_components() per subgraph.
+	/// Requires at most 64 vertices and 64 edges.
+	class SubgraphWalk {
+	public:
+		using mask_type = uint64_t;
+
+		explicit SubgraphWalk(const Graph& graph);
+
+		/// @brief Toggle the next edge.
+		/// @return False (without changing anything) if all subsets have been visited.
+		bool next();
+
+		/// @brief The current subgraph.
+		const Graph& graph() const { return graph_; }
+
+		/// @brief Edges (i, j) with i < j of the graph in row-major order.
+		const std::vector<std::pair<int, int>>& edges() const { return edges_; }
+
+		/// @brief Edge mask of the current subgraph (bit e stands for edges()[e]).
+		mask_type mask() const { return mask_; }
+
+		/// @brief Number of steps taken so far.
+		uint64_t step() const { return step_; }
+
+		/// @brief Index into edges() of the edge toggled by the last step or -1 before the first step.
+		int toggled_edge() const { return toggled_edge_; }
+
+		/// @brief Whether the last step inserted (and not removed) its edge.
+		bool edge_inserted() const { return toggled_edge_ >= 0 && ((mask_ >> toggled_edge_) & 1); }
+
+		std::span<const int> degrees() const { return degrees_; }
+		int edge_count() const { return edge_count_; }
+
+		/// @brief Number of connected components, counting isolated vertices.
+		int component_count() const { return component_count_; }
+
+		/// @brief Graph::compress() of the current subgraph. Requires n <= 11.
+		uint64_t code() const;
+
+	private:
+		Graph graph_;
+		std::vector<std::pair<int, int>> edges_;
+		std::vector<uint64_t> edge_codes;
+		std::vector<uint64_t> rows;
+		std::vector<int> degrees_;
+		mask_type mask_{};
+		mask_type last_step{};
+		uint64_t step_{};
+		uint64_t code_{};
+		int toggled_edge_{ -1 };
+		int edge_count_{};
+		int component_count_{};
+
+		/// Whether v can be reached from u in the current subgraph.
+		bool connected(int u, int v) const;
+	};
+
+
+	/// @brief Lazily enumerate all subgraphs with at least min_edges and at most max_edges edges
+	///    (see SubgraphRange).
+	inline SubgraphRange subgraphs(const Graph& graph, int min_edges = 0, int max_edges = std::numeric_limits<int>::max()) {
+		return SubgraphRange{ graph, min_edges, max_edges };
+	}
+
+
+	/// @brief Visit all subgraphs of the range and combine the results, in parallel if a pool is
+	///    given.
+	///
+	/// The range is split into chunks of consecutive subgraphs (a few per thread) that start by
+	/// unranking their first edge mask, so no coordination between the threads is needed. Each
+	/// chunk accumulates into a value-initialized T{} by calling visit(accumulator, subgraph, mask),
+	/// and the chunk results are folded into init with combine(result, chunk_result) in iteration
+	/// order, so the result does not depend on the scheduling. T{} thus needs to be neutral with
+	/// respect to combine, while init is counted exactly once as in the sequential case.
+	template<class T, class Visit, class Combine>
+	T reduce_subgraphs(const SubgraphRange& range, T init, Visit&& visit, Combine&& combine, Q::ThreadPool* pool = nullptr) {
+		auto run = [&](const SubgraphRange::Chunk& chunk, T& accumulator) {
+			auto it = range.at(chunk.edge_count, chunk.rank);
+			for (uint64_t i = 0; i < chunk.size; ++i, ++it) visit(accumulator, *it, it.mask());
+		};
+		if (pool == nullptr) {
+			for (const auto& chunk : range.split(1)) run(chunk, init);
+			return init;
+		}
+		std::vector<std::future<T>> results;
+		for (const auto& chunk : range.split(4 * pool->size(), 1024)) {
+			results.push_back(pool->submit([&run, chunk] {
+				T accumulator{};
+				run(chunk, accumulator);
+				return accumulator;
+			}));
+		}
+		for (auto& result : results) result.wait();
+		for (auto& result : results) combine(init, result.get());
+		return init;
+	}
+
+	/// @brief Call visit(subgraph, mask) for all subgraphs of the range, concurrently from the
+	///    pool's threads if a pool is given (see reduce_subgraphs()).
+	template<class Visit>
+	void for_each_subgraph(const SubgraphRange& range, Visit&& visit, Q::ThreadPool* pool = nullptr) {
+		struct Empty {};
+		reduce_subgraphs(
+			range, Empty{}, [&](Empty&, const Graph& subgraph, SubgraphRange::mask_type mask) { visit(subgraph, mask); },
+			[](Empty&, Empty) {}, pool);
+	}
+
+}
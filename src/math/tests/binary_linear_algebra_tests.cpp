@@ -0,0 +1,151 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+#include "binary_linear_algebra.h"
+#include <random>
+
+using namespace qe;
+
+
+static BitMatrix random_bit_matrix(size_t rows, size_t cols, unsigned int seed, int density = 2) {
+	std::mt19937 rng{ seed };
+	BitMatrix mat(rows, cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			if (rng() % density == 0) mat.set(i, j);
+		}
+	}
+	return mat;
+}
+
+/// Straightforward element-wise Gauss-Jordan elimination as a reference.
+static std::vector<size_t> reference_rref(Matrix<Binary>& mat) {
+	std::vector<size_t> pivots;
+	size_t r = 0;
+	for (size_t c = 0; c < mat.cols() && r < mat.rows(); ++c) {
+		size_t p = r;
+		while (p < mat.rows() && mat(p, c) == 0) ++p;
+		if (p == mat.rows()) continue;
+		for (size_t j = 0; j < mat.cols(); ++j) std::swap(mat(p, j), mat(r, j));
+		for (size_t i = 0; i < mat.rows(); ++i) {
+			if (i == r || mat(i, c) == 0) continue;
+			for (size_t j = 0; j < mat.cols(); ++j) mat(i, j) += mat(r, j);
+		}
+		pivots.push_back(c);
+		++r;
+	}
+	return pivots;
+}
+
+
+TEST_CASE("rank()") {
+	REQUIRE(rank(BitMatrix::identity(5)) == 5);
+	REQUIRE(rank(BitMatrix(4, 7)) == 0);
+	REQUIRE(rank(BitMatrix{ 3, 3, { 1, 1, 0, 0, 1, 1, 1, 0, 1 } }) == 2);
+	REQUIRE(rank(Matrix<Binary>{ 2, 3, { 1, 0, 1, 1, 0, 1 } }) == 1);
+	REQUIRE(rank(BitMatrix::identity(200)) == 200);
+	REQUIRE(rank(BitMatrix(100, 150, 1)) == 1);
+}
+
+TEST_CASE("echelonize() matches reference elimination") {
+	for (auto [rows, cols, density] : { std::tuple<size_t, size_t, int>{ 5, 9, 2 }, { 40, 40, 2 }, { 70, 130, 2 }, { 130, 70, 3 }, { 300, 200, 5 }, { 100, 300, 40 } }) {
+		auto mat = random_bit_matrix(rows, cols, rows + cols, density);
+		auto expected = mat.to_matrix();
+		auto expected_pivots = reference_rref(expected);
+
+		auto reduced = mat;
+		auto pivots = echelonize(reduced);
+		REQUIRE(pivots == expected_pivots);
+		REQUIRE(reduced.to_matrix() == expected);
+		REQUIRE(rank(mat) == expected_pivots.size());
+
+		auto echelon = mat;
+		REQUIRE(echelonize(echelon, false) == expected_pivots);
+		for (size_t i = 0; i < pivots.size(); ++i) {
+			for (size_t k = i + 1; k < rows; ++k) REQUIRE(!echelon.get(k, pivots[i]));
+		}
+	}
+}
+
+TEST_CASE("echelonize() with restricted pivot columns") {
+	BitMatrix mat{ 2, 4, { 0, 0, 1, 1, 0, 0, 0, 1 } };
+	REQUIRE(echelonize(mat, true, 2).empty());
+	REQUIRE(echelonize(mat, true, 3) == std::vector<size_t>{ 2 });
+}
+
+TEST_CASE("row_reduce()") {
+	for (auto [rows, cols] : { std::pair<size_t, size_t>{ 4, 6 }, { 30, 20 }, { 80, 100 }, { 150, 150 } }) {
+		auto mat = random_bit_matrix(rows, cols, rows * cols);
+		auto result = row_reduce(mat);
+
+		auto expected = mat.to_matrix();
+		REQUIRE(result.pivot_columns == reference_rref(expected));
+		REQUIRE(result.reduced.to_matrix() == expected);
+		REQUIRE(result.rank() == rank(mat));
+		REQUIRE(result.transformation.rows() == rows);
+		REQUIRE(result.transformation.cols() == rows);
+		REQUIRE(rank(result.transformation) == rows);
+		REQUIRE(result.transformation.to_matrix() * mat.to_matrix() == expected);
+	}
+
+	auto result = row_reduce(Matrix<Binary>{ 2, 2, { 0, 1, 1, 1 } });
+	REQUIRE(result.reduced == BitMatrix::identity(2));
+	REQUIRE(result.transformation == BitMatrix{ 2, 2, { 1, 1, 1, 0 } });
+}
+
+TEST_CASE("inverse()") {
+	REQUIRE(inverse(BitMatrix::identity(3)) == BitMatrix::identity(3));
+	REQUIRE(inverse(BitMatrix{ 2, 2, { 1, 1, 1, 1 } }) == std::nullopt);
+	REQUIRE(inverse(Matrix<Binary>{ 2, 2, { 1, 1, 0, 1 } }) == Matrix<Binary>{ 2, 2, { 1, 1, 0, 1 } });
+
+	std::mt19937 rng{ 42 };
+	for (size_t n : { 5, 64, 100 }) {
+		// Random invertible matrix as product of a unit lower and a unit upper triangular matrix.
+		Matrix<Binary> lower = Matrix<Binary>::identity(n);
+		Matrix<Binary> upper = Matrix<Binary>::identity(n);
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t j = 0; j < i; ++j) {
+				lower(i, j) = Binary{ static_cast<int>(rng() & 1) };
+				upper(j, i) = Binary{ static_cast<int>(rng() & 1) };
+			}
+		}
+		const BitMatrix mat{ lower * upper };
+		auto inv = inverse(mat);
+		REQUIRE(inv.has_value());
+		REQUIRE(inv->to_matrix() * mat.to_matrix() == Matrix<Binary>::identity(n));
+		REQUIRE(mat.to_matrix() * inv->to_matrix() == Matrix<Binary>::identity(n));
+	}
+}
+
+TEST_CASE("solve()") {
+	for (auto [rows, cols, rhs] : { std::tuple<size_t, size_t, size_t>{ 6, 4, 3 }, { 50, 80, 10 }, { 120, 70, 65 } }) {
+		auto a = random_bit_matrix(rows, cols, rows + cols + rhs);
+		auto x = random_bit_matrix(cols, rhs, rhs);
+		const BitMatrix b{ a.to_matrix() * x.to_matrix() };
+		auto solution = solve(a, b);
+		REQUIRE(solution.has_value());
+		REQUIRE(solution->rows() == cols);
+		REQUIRE(solution->cols() == rhs);
+		REQUIRE(a.to_matrix() * solution->to_matrix() == b.to_matrix());
+	}
+
+	Matrix<Binary> a{ 3, 2, { 1, 0, 0, 1, 1, 1 } };
+	REQUIRE(solve(a, Matrix<Binary>{ 3, 1, { 1, 1, 0 } }) == Matrix<Binary>{ 2, 1, { 1, 1 } });
+	REQUIRE(solve(a, Matrix<Binary>{ 3, 1, { 1, 1, 1 } }) == std::nullopt);
+	REQUIRE(solve(a, Matrix<Binary>{ 3, 2, { 1, 1, 1, 0, 0, 1 } }) == Matrix<Binary>{ 2, 2, { 1, 1, 1, 0 } });
+}
+
+TEST_CASE("nullspace()") {
+	REQUIRE(nullspace(BitMatrix::identity(4)).rows() == 0);
+	REQUIRE(nullspace(BitMatrix(2, 3)) == BitMatrix::identity(3));
+	REQUIRE(nullspace(Matrix<Binary>{ 1, 3, { 1, 1, 1 } }) == Matrix<Binary>{ 2, 3, { 1, 1, 0, 1, 0, 1 } });
+
+	for (auto [rows, cols] : { std::pair<size_t, size_t>{ 5, 9 }, { 60, 100 }, { 100, 140 }, { 140, 100 } }) {
+		auto a = random_bit_matrix(rows, cols, rows * 7 + cols, 3);
+		auto basis = nullspace(a);
+		REQUIRE(basis.rows() == cols - rank(a));
+		REQUIRE(basis.cols() == cols);
+		REQUIRE(rank(basis) == basis.rows());
+		REQUIRE(a.to_matrix() * basis.transpose().to_matrix() == Matrix<Binary>(rows, basis.rows()));
+	}
+}
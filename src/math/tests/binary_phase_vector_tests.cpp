@@ -0,0 +1,88 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "binary_phase_vector.h"
+#include <random>
+
+using namespace qe;
+
+
+static std::vector<BinaryPhase> random_phases(size_t size, unsigned int seed) {
+	std::mt19937 rng{ seed };
+	std::vector<BinaryPhase> phases(size);
+	for (auto& phase : phases) phase = static_cast<int>(rng() % 4);
+	return phases;
+}
+
+
+TEST_CASE("BinaryPhaseVector constructor") {
+	BinaryPhaseVector empty;
+	REQUIRE(empty.empty());
+
+	BinaryPhaseVector zeros(70);
+	REQUIRE(zeros.size() == 70);
+	REQUIRE(zeros.num_words() == 3);
+	for (size_t i = 0; i < zeros.size(); ++i) REQUIRE(zeros[i] == 0);
+
+	BinaryPhaseVector threes(33, 3);
+	REQUIRE(threes[32] == 3);
+	REQUIRE(threes.data()[1] == 0b11);
+
+	BinaryPhaseVector phases{ 0, 1, 2, 3, 1 };
+	REQUIRE(phases.to_vector() == std::vector<BinaryPhase>{ 0, 1, 2, 3, 1 });
+
+	const auto values = random_phases(100, 1);
+	REQUIRE(BinaryPhaseVector{ values }.to_vector() == values);
+}
+
+TEST_CASE("BinaryPhaseVector element access") {
+	BinaryPhaseVector phases(40);
+	phases[35] = 2;
+	phases[36] = 3;
+	phases[36] += 3;
+	phases[0] -= 1;
+	REQUIRE(phases[35] == 2);
+	REQUIRE(phases[36] == 2);
+	REQUIRE(phases[0] == 3);
+	REQUIRE(phases[1] == 0);
+	REQUIRE(phases[34] == 0);
+}
+
+TEST_CASE("BinaryPhaseVector arithmetic") {
+	for (size_t size : { 1, 31, 32, 33, 200 }) {
+		const auto a = random_phases(size, static_cast<unsigned int>(size));
+		const auto b = random_phases(size, static_cast<unsigned int>(size + 1));
+		const BinaryPhaseVector pa{ a };
+		const BinaryPhaseVector pb{ b };
+
+		const auto sum = (pa + pb).to_vector();
+		const auto difference = (pa - pb).to_vector();
+		const auto negated = (-pa).to_vector();
+		auto shifted = pa;
+		shifted += BinaryPhase{ 3 };
+		auto shifted_back = shifted;
+		shifted_back -= BinaryPhase{ 3 };
+		for (size_t i = 0; i < size; ++i) {
+			REQUIRE(sum[i] == a[i] + b[i]);
+			REQUIRE(difference[i] == a[i] - b[i]);
+			REQUIRE(negated[i] == BinaryPhase{ 0 } - a[i]);
+			REQUIRE(shifted[i] == a[i] + 3);
+		}
+		REQUIRE(shifted_back == pa);
+	}
+}
+
+TEST_CASE("BinaryPhaseVector add_minus()") {
+	const auto values = random_phases(100, 5);
+	BinaryPhaseVector phases{ values };
+	const std::vector<uint64_t> bits{ 0x8000'0001'0000'0003, 0b101 << 30 };
+	phases.add_minus(bits);
+	for (size_t i = 0; i < values.size(); ++i) {
+		const bool flip = (bits[i / 64] >> (i % 64)) & 1;
+		REQUIRE(phases[i] == values[i] + 2 * flip);
+	}
+
+	// Bits beyond the size must not leak into the padding.
+	BinaryPhaseVector small{ BinaryPhase{ 1 }, BinaryPhase{ 2 }, BinaryPhase{ 3 } };
+	small.add_minus(std::vector<uint64_t>{ ~uint64_t{} });
+	REQUIRE(small == BinaryPhaseVector{ BinaryPhase{ 3 }, BinaryPhase{ 0 }, BinaryPhase{ 1 } });
+}
@@ -0,0 +1,84 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "bit_kernels.h"
+#include "bit_matrix.h"
+#include <algorithm>
+#include <bit>
+#include <random>
+
+using namespace qe;
+using bit_kernels::word_type;
+
+
+static std::vector<word_type> random_words(size_t n, unsigned int seed) {
+	std::mt19937_64 rng{ seed };
+	std::vector<word_type> words(n);
+	for (auto& w : words) w = rng();
+	return words;
+}
+
+
+TEST_CASE("bit_kernels implementations") {
+	const auto implementations = bit_kernels::available_implementations();
+	REQUIRE(implementations.front() == "scalar");
+	REQUIRE(bit_kernels::implementation() == implementations.back());
+	REQUIRE(!bit_kernels::select_implementation("unknown"));
+	const auto original = bit_kernels::implementation();
+
+	for (auto name : implementations) {
+		REQUIRE(bit_kernels::select_implementation(name));
+		REQUIRE(bit_kernels::implementation() == name);
+
+		for (size_t n : { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100 }) {
+			const auto a = random_words(n, static_cast<unsigned int>(n));
+			const auto b = random_words(n, static_cast<unsigned int>(n + 1000));
+
+			const auto c = random_words(n, static_cast<unsigned int>(n + 2000));
+			auto target = c;
+			bit_kernels::xor_and_into(target.data(), a.data(), b.data(), n);
+			for (size_t k = 0; k < n; ++k) REQUIRE(target[k] == (c[k] ^ (a[k] & b[k])));
+
+			target = a;
+			bit_kernels::xor_into(target.data(), b.data(), n);
+			size_t expected_popcount{};
+			size_t expected_and_popcount{};
+			word_type expected_parity{};
+			for (size_t k = 0; k < n; ++k) {
+				REQUIRE(target[k] == (a[k] ^ b[k]));
+				expected_popcount += std::popcount(a[k]);
+				expected_and_popcount += std::popcount(a[k] & b[k]);
+				expected_parity ^= a[k];
+			}
+			REQUIRE(bit_kernels::popcount(a.data(), n) == expected_popcount);
+			REQUIRE(bit_kernels::and_popcount(a.data(), b.data(), n) == expected_and_popcount);
+			REQUIRE(bit_kernels::parity(a.data(), n) == (std::popcount(expected_parity) % 2 == 1));
+
+			std::vector<word_type> sparse(n);
+			REQUIRE(bit_kernels::find_first_set(sparse.data(), n) == n * 64);
+			for (size_t bit : { size_t{ 0 }, size_t{ 63 }, n * 64 / 2 + 5, n * 64 - 1 }) {
+				if (bit >= n * 64) continue;
+				std::fill(sparse.begin(), sparse.end(), 0);
+				sparse[bit / 64] |= word_type{ 1 } << (bit % 64);
+				sparse.back() |= word_type{ 1 } << 63;
+				REQUIRE(bit_kernels::find_first_set(sparse.data(), n) == bit);
+			}
+		}
+	}
+	bit_kernels::select_implementation(original);
+}
+
+TEST_CASE("BitMatrix row operations with kernels") {
+	BitMatrix mat(3, 500);
+	for (size_t j = 0; j < 500; j += 3) mat.set(0, j);
+	for (size_t j = 0; j < 500; j += 2) mat.set(1, j);
+	REQUIRE(mat.row_count(0) == 167);
+	REQUIRE(mat.row_and_count(0, 1) == 84);
+	REQUIRE(mat.row_parity(0));
+	REQUIRE(!mat.row_parity(1));
+	REQUIRE(mat.row_find_first(2) == 500);
+	mat.set(2, 321);
+	REQUIRE(mat.row_find_first(2) == 321);
+	mat.xor_row(1, 0);
+	REQUIRE(mat.row_count(1) == 250 + 167 - 2 * 84);
+	REQUIRE(mat.count() == 250 + 167 - 2 * 84 + 167 + 1);
+}
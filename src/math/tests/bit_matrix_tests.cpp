@@ -0,0 +1,134 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+#include "bit_matrix.h"
+#include "format_bit_matrix.h"
+#include <random>
+
+using namespace qe;
+
+
+static BitMatrix random_bit_matrix(size_t rows, size_t cols, unsigned int seed) {
+	std::mt19937 rng{ seed };
+	BitMatrix mat(rows, cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			if (rng() & 1) mat.set(i, j);
+		}
+	}
+	return mat;
+}
+
+
+TEST_CASE("BitMatrix constructor") {
+	BitMatrix mat(3, 70);
+	REQUIRE(mat.rows() == 3);
+	REQUIRE(mat.cols() == 70);
+	REQUIRE(mat.words_per_row() == 2);
+	REQUIRE(mat.count() == 0);
+
+	BitMatrix ones(3, 70, 1);
+	REQUIRE(ones.count() == 210);
+	REQUIRE(ones.row_count(1) == 70);
+
+	BitMatrix mat2{ 2, 3, { 1, 0, 1, 0, 1 } };
+	REQUIRE(mat2(0, 0) == 1);
+	REQUIRE(mat2(0, 1) == 0);
+	REQUIRE(mat2(0, 2) == 1);
+	REQUIRE(mat2(1, 1) == 1);
+	REQUIRE(mat2(1, 2) == 0);
+}
+
+TEST_CASE("BitMatrix element access") {
+	BitMatrix mat(4, 130);
+	mat(2, 129) = 1;
+	mat.set(3, 64);
+	REQUIRE(mat.get(2, 129));
+	REQUIRE(mat.get(3, 64));
+	REQUIRE(mat.count() == 2);
+
+	mat(2, 129).negate();
+	REQUIRE(!mat.get(2, 129));
+	mat.flip(0, 5);
+	REQUIRE(mat(0, 5) == 1);
+	mat.reset(0, 5);
+	REQUIRE(mat(0, 5) == 0);
+}
+
+TEST_CASE("BitMatrix conversion from and to Matrix<Binary>") {
+	Matrix<Binary> dense{ 2, 3, { 1, 0, 1, 1, 1, 0 } };
+	BitMatrix packed{ dense };
+	REQUIRE(packed == BitMatrix{ 2, 3, { 1, 0, 1, 1, 1, 0 } });
+	REQUIRE(packed.to_matrix() == dense);
+
+	Matrix<Binary, 2, 2> fixed{ 0, 1, 1, 1 };
+	REQUIRE(BitMatrix{ fixed } == BitMatrix{ 2, 2, { 0, 1, 1, 1 } });
+}
+
+TEST_CASE("BitMatrix row operations") {
+	BitMatrix mat{ 3, 4, { 1, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 1 } };
+	mat.xor_row(0, 1);
+	REQUIRE(mat == BitMatrix{ 3, 4, { 1, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1 } });
+	mat.and_row(2, 1);
+	REQUIRE(mat == BitMatrix{ 3, 4, { 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0 } });
+	mat.or_row(1, 0);
+	REQUIRE(mat == BitMatrix{ 3, 4, { 1, 0, 1, 0, 1, 1, 1, 0, 0, 1, 1, 0 } });
+	mat.swap_rows(0, 2);
+	REQUIRE(mat == BitMatrix{ 3, 4, { 0, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0 } });
+	mat.swap_cols(0, 3);
+	REQUIRE(mat == BitMatrix{ 3, 4, { 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 1, 1 } });
+
+	REQUIRE(mat.row(0).size() == 1);
+	REQUIRE(mat.row(0)[0] == 0b0110);
+	REQUIRE(mat.col(3) == BitMatrix{ 3, 1, { 0, 1, 1 } });
+}
+
+TEST_CASE("BitMatrix arithmetic") {
+	const auto a = random_bit_matrix(5, 100, 1);
+	const auto b = random_bit_matrix(5, 100, 2);
+	const auto sum = a + b;
+	const auto product = a & b;
+	const auto either = a | b;
+	for (size_t i = 0; i < a.rows(); ++i) {
+		for (size_t j = 0; j < a.cols(); ++j) {
+			REQUIRE(sum(i, j) == a(i, j) + b(i, j));
+			REQUIRE(product(i, j) == (a(i, j) & b(i, j)));
+			REQUIRE(either(i, j) == (a(i, j) | b(i, j)));
+		}
+	}
+	REQUIRE(a + a == BitMatrix(5, 100));
+}
+
+TEST_CASE("BitMatrix transpose") {
+	for (auto [rows, cols] : { std::pair{ 1, 1 }, { 3, 5 }, { 64, 64 }, { 70, 130 }, { 129, 17 } }) {
+		auto mat = random_bit_matrix(rows, cols, rows * 1000 + cols);
+		auto transposed = mat.transpose();
+		REQUIRE(transposed.rows() == mat.cols());
+		REQUIRE(transposed.cols() == mat.rows());
+		REQUIRE(transposed.count() == mat.count());
+		REQUIRE(transposed.to_matrix() == mat.to_matrix().transpose());
+		REQUIRE(transposed.transpose() == mat);
+	}
+}
+
+TEST_CASE("BitMatrix factory functions") {
+	REQUIRE(BitMatrix::identity(3) == BitMatrix{ 3, 3, { 1, 0, 0, 0, 1, 0, 0, 0, 1 } });
+	REQUIRE(BitMatrix::zero(2, 3) == BitMatrix{ 2, 3 });
+}
+
+TEST_CASE("Format BitMatrix") {
+	REQUIRE(fmt::format("{}", BitMatrix{ 2, 2, { 1, 0, 0, 1 } }) == "| 1 0 |\n| 0 1 |\n");
+}
+
+TEST_CASE("BitMatrix multiplication") {
+	REQUIRE(BitMatrix{ 2, 2, { 1, 1, 0, 1 } } * BitMatrix{ 2, 2, { 1, 1, 0, 1 } } == BitMatrix::identity(2));
+
+	for (auto [m, n, p] : { std::tuple{ 1, 1, 1 }, { 3, 5, 2 }, { 20, 9, 70 }, { 64, 64, 64 }, { 100, 130, 90 } }) {
+		auto a = random_bit_matrix(m, n, m + n);
+		auto b = random_bit_matrix(n, p, n + p);
+		const auto expected = a.to_matrix().operator*(b.to_matrix());
+		REQUIRE((a * b).to_matrix() == expected);
+		REQUIRE(a.to_matrix() * b.to_matrix() == expected);
+		REQUIRE(a * BitMatrix::identity(n) == a);
+	}
+}
@@ -0,0 +1,131 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "canonical_labeling.h"
+#include "test_graphs.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <set>
+
+using namespace qe;
+
+
+static std::vector<int> random_permutation(int n, std::mt19937& rng) {
+	std::vector<int> permutation(n);
+	std::iota(permutation.begin(), permutation.end(), 0);
+	std::shuffle(permutation.begin(), permutation.end(), rng);
+	return permutation;
+}
+
+
+TEST_CASE("graph_isomorphism() keeps the graph symmetric") {
+	const auto graph = Graph::linear(4).graph_isomorphism({ 2, 0, 3, 1 });
+	REQUIRE(graph == Graph(4, { { 2, 0 }, { 0, 3 }, { 3, 1 } }));
+}
+
+TEST_CASE("canonical_form()") {
+	const auto form = canonical_form(Graph::star(5, 3));
+	REQUIRE(form.graph == Graph::star(5, 3).graph_isomorphism(form.labeling));
+	REQUIRE(form.graph == canonical_form(Graph::star(5, 0)).graph);
+	REQUIRE(canonical_form(Graph(0)).labeling.empty());
+	REQUIRE(canonical_code(Graph(1)) == 0);
+}
+
+TEST_CASE("canonical_code() is invariant under relabeling") {
+	std::mt19937 rng{ 1 };
+	for (int n : { 2, 5, 8, 11 }) {
+		for (double density : { 0.5, 0.25 }) {
+			for (int sample = 0; sample < 10; ++sample) {
+				const auto graph = random_graph(n, rng, density);
+				const auto code = canonical_code(graph);
+				for (int k = 0; k < 5; ++k) {
+					REQUIRE(canonical_code(graph.graph_isomorphism(random_permutation(n, rng))) == code);
+				}
+			}
+		}
+	}
+	for (auto graph : { Graph::cycle(10), Graph::fully_connected(9), Graph::star(11), Graph(7), Graph::pusteblume(8) }) {
+		const int n = graph.num_vertices();
+		REQUIRE(canonical_code(graph.graph_isomorphism(random_permutation(n, rng))) == canonical_code(graph));
+	}
+}
+
+TEST_CASE("canonical_code() separates non-isomorphic graphs") {
+	// There are 11 graphs on 4 vertices and 156 on 6 vertices up to isomorphism.
+	for (auto [n, expected] : { std::pair{ 4, 11 }, { 6, 156 } }) {
+		std::set<uint64_t> classes;
+		const uint64_t num_codes = uint64_t{ 1 } << (n * (n - 1) / 2);
+		for (uint64_t code = 0; code < num_codes; ++code) {
+			classes.insert(canonical_code(Graph::decompress(n, code)));
+		}
+		REQUIRE(classes.size() == static_cast<size_t>(expected));
+	}
+	REQUIRE(!is_isomorphic(Graph::cycle(6), Graph(6, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 5 }, { 5, 3 } })));
+	REQUIRE(is_isomorphic(Graph::linear(5), Graph(5, { { 3, 1 }, { 1, 4 }, { 4, 0 }, { 0, 2 } })));
+}
+
+TEST_CASE("canonical_form() of larger graphs") {
+	std::mt19937 rng{ 2 };
+	for (int n : { 20, 64 }) {
+		const auto graph = random_graph(n, rng);
+		const auto permuted = graph.graph_isomorphism(random_permutation(n, rng));
+		REQUIRE(is_isomorphic(graph, permuted));
+		auto modified = permuted;
+		modified.toggle_edge(0, 1);
+		REQUIRE(!is_isomorphic(graph, modified));
+	}
+	// Highly symmetric graphs need the automorphism pruning to finish quickly.
+	Graph disjoint_triangles(30);
+	for (int t = 0; t < 10; ++t) disjoint_triangles.add_path({ 3 * t, 3 * t + 1, 3 * t + 2, 3 * t });
+	REQUIRE(is_isomorphic(disjoint_triangles, disjoint_triangles.graph_isomorphism(random_permutation(30, rng))));
+}
+
+TEST_CASE("automorphism_group()") {
+	auto check_generators = [](const Graph& graph, const AutomorphismGroup& group) {
+		for (const auto& generator : group.generators) REQUIRE(graph.graph_isomorphism(generator) == graph);
+	};
+	auto factorial = [](int n) { double result = 1; for (int k = 2; k <= n; ++k) result *= k; return result; };
+
+	for (int n : { 3, 6, 11 }) {
+		const auto cycle = automorphism_group(Graph::cycle(n));
+		REQUIRE(cycle.order == 2 * n);
+		REQUIRE(cycle.orbits == std::vector<int>(n, 0));
+		check_generators(Graph::cycle(n), cycle);
+
+		REQUIRE(automorphism_group(Graph::star(n, 1)).order == factorial(n - 1));
+		REQUIRE(automorphism_group(Graph::fully_connected(n)).order == factorial(n));
+		REQUIRE(automorphism_group(Graph(n)).order == factorial(n));
+		REQUIRE(automorphism_group(Graph::linear(n)).order == 2);
+	}
+
+	const auto star = automorphism_group(Graph::star(5, 2));
+	REQUIRE(star.orbits == std::vector<int>{ 0, 0, 2, 0, 0 });
+
+	const auto pusteblume = automorphism_group(Graph::pusteblume(7));
+	REQUIRE(pusteblume.order == 2 * 6);
+	REQUIRE(pusteblume.orbits == std::vector<int>{ 0, 1, 1, 3, 4, 4, 4 });
+
+	Graph petersen(10, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 0 }, { 0, 5 }, { 1, 6 }, { 2, 7 }, { 3, 8 }, { 4, 9 },
+						 { 5, 7 }, { 7, 9 }, { 9, 6 }, { 6, 8 }, { 8, 5 } });
+	const auto petersen_group = automorphism_group(petersen);
+	REQUIRE(petersen_group.order == 120);
+	check_generators(petersen, petersen_group);
+
+	Graph triangles(30);
+	for (int t = 0; t < 10; ++t) triangles.add_path({ 3 * t, 3 * t + 1, 3 * t + 2, 3 * t });
+	REQUIRE(automorphism_group(triangles).order == std::pow(6., 10) * factorial(10));
+
+	// Brute force over all permutations for random graphs.
+	std::mt19937 rng{ 3 };
+	for (int sample = 0; sample < 20; ++sample) {
+		const auto graph = random_graph(6, rng, 1.0 / 3);
+		std::vector<int> permutation{ 0, 1, 2, 3, 4, 5 };
+		int order{};
+		do order += graph.graph_isomorphism(permutation) == graph;
+		while (std::next_permutation(permutation.begin(), permutation.end()));
+		const auto group = automorphism_group(graph);
+		REQUIRE(group.order == order);
+		check_generators(graph, group);
+	}
+}
@@ -0,0 +1,62 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "cut_rank.h"
+#include "binary_linear_algebra.h"
+#include "thread_pool.h"
+#include "test_graphs.h"
+#include <random>
+
+using namespace qe;
+
+
+static int reference_cut_rank(const Graph& graph, uint64_t subset) {
+	std::vector<int> vertices;
+	for (int v = 0; v < graph.num_vertices(); ++v) {
+		if ((subset >> v) & 1) vertices.push_back(v);
+	}
+	return cut_rank(graph, vertices);
+}
+
+
+TEST_CASE("cut_rank()") {
+	REQUIRE(cut_rank(Graph::star(5), 0b00001) == 1);
+	REQUIRE(cut_rank(Graph::star(5), 0b00110) == 1);
+	REQUIRE(cut_rank(Graph(4), 0b0011) == 0);
+	REQUIRE(cut_rank(Graph::linear(6), 0b000111) == 1);
+	REQUIRE(cut_rank(Graph::linear(6), 0b010101) == 3);
+	REQUIRE(cut_rank(Graph::cycle(6), 0b000111) == 2);
+	REQUIRE(cut_rank(Graph::fully_connected(5), 0b00011) == 1);
+
+	std::mt19937 rng{ 1 };
+	const auto graph = random_graph(12, rng);
+	for (uint64_t subset : { 0b1ull, 0b101010101010ull, 0b111111ull, 0b100000000001ull }) {
+		REQUIRE(cut_rank(graph, subset) == reference_cut_rank(graph, subset));
+	}
+}
+
+TEST_CASE("cut_ranks() of all bipartitions") {
+	std::mt19937 rng{ 2 };
+	for (int n : { 1, 2, 5, 11 }) {
+		const auto graph = random_graph(n, rng);
+		const auto ranks = cut_ranks(graph);
+		REQUIRE(ranks.size() == (size_t{ 1 } << (n - 1)));
+		for (uint64_t subset = 0; subset < ranks.size(); ++subset) {
+			REQUIRE(ranks[subset] == reference_cut_rank(graph, subset));
+		}
+	}
+
+	const auto graph = random_graph(16, rng);
+	Q::ThreadPool pool{ 3 };
+	REQUIRE(cut_ranks(graph, &pool) == cut_ranks(graph));
+}
+
+TEST_CASE("cut_ranks() of a batch of cuts") {
+	std::mt19937 rng{ 4 };
+	const auto graph = random_graph(20, rng);
+	std::vector<uint64_t> subsets;
+	for (int k = 0; k < 500; ++k) subsets.push_back(rng() & 0xFFFFF);
+	Q::ThreadPool pool{ 2 };
+	const auto ranks = cut_ranks(graph, subsets, &pool);
+	REQUIRE(ranks == cut_ranks(graph, subsets));
+	for (size_t k = 0; k < subsets.size(); ++k) REQUIRE(ranks[k] == reference_cut_rank(graph, subsets[k]));
+}
@@ -0,0 +1,89 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "graph_batch.h"
+#include "test_graphs.h"
+#include <random>
+
+using namespace qe;
+
+
+static std::vector<Graph> random_graphs(int num_vertices, size_t count, unsigned int seed) {
+	std::mt19937 rng{ seed };
+	std::vector<Graph> graphs;
+	for (size_t g = 0; g < count; ++g) graphs.push_back(random_graph(num_vertices, rng));
+	return graphs;
+}
+
+
+TEST_CASE("GraphBatch get() and set()") {
+	const auto graphs = random_graphs(7, 130, 1);
+	GraphBatch batch{ graphs };
+	REQUIRE(batch.size() == 130);
+	REQUIRE(batch.num_vertices() == 7);
+	REQUIRE(batch.words_per_slice() == 3);
+	REQUIRE(batch.num_slices() == 21);
+	for (size_t g = 0; g < graphs.size(); ++g) {
+		REQUIRE(batch.get(g) == graphs[g]);
+		REQUIRE(batch.code(g) == Graph::compress(graphs[g]));
+	}
+	batch.set(5, Graph::star(7));
+	REQUIRE(batch.get(5) == Graph::star(7));
+	REQUIRE(batch.has_edge(5, 3, 0));
+	REQUIRE(!batch.has_edge(5, 3, 4));
+	REQUIRE(batch.get(4) == graphs[4]);
+
+	// Decoding into an existing graph overwrites all of its edges.
+	auto scratch = Graph::fully_connected(7);
+	batch.get(5, scratch);
+	REQUIRE(scratch == Graph::star(7));
+	batch.get(4, scratch);
+	REQUIRE(scratch == graphs[4]);
+}
+
+TEST_CASE("GraphBatch toggle_edge()") {
+	auto graphs = random_graphs(6, 100, 2);
+	GraphBatch batch{ graphs };
+	batch.toggle_edge(4, 1);
+	std::vector<GraphBatch::word_type> lanes{ 0b1010, 0 };
+	batch.toggle_edge(0, 5, lanes);
+	for (size_t g = 0; g < graphs.size(); ++g) {
+		graphs[g].toggle_edge(1, 4);
+		if (g == 1 || g == 3) graphs[g].toggle_edge(0, 5);
+		REQUIRE(batch.get(g) == graphs[g]);
+	}
+	// Lanes beyond the batch size stay empty.
+	REQUIRE(batch.slice(1, 4)[1] >> (100 - 64) == 0);
+}
+
+TEST_CASE("GraphBatch local_complementation()") {
+	for (int n : { 2, 5, 9, 12 }) {
+		auto graphs = random_graphs(n, 517, n);
+		GraphBatch batch{ graphs };
+		std::mt19937 rng{ 3 };
+		for (int step = 0; step < 20; ++step) {
+			const int vertex = static_cast<int>(rng() % n);
+			batch.local_complementation(vertex);
+			for (auto& graph : graphs) graph.local_complementation(vertex);
+		}
+		for (size_t g = 0; g < graphs.size(); ++g) REQUIRE(batch.get(g) == graphs[g]);
+
+		std::vector<GraphBatch::word_type> lanes(batch.words_per_slice());
+		for (auto& word : lanes) word = (GraphBatch::word_type{ rng() } << 32) | rng();
+		batch.local_complementation(n - 1, lanes);
+		for (size_t g = 0; g < graphs.size(); ++g) {
+			if ((lanes[g / 64] >> (g % 64)) & 1) graphs[g].local_complementation(n - 1);
+			REQUIRE(batch.get(g) == graphs[g]);
+		}
+	}
+}
+
+TEST_CASE("GraphBatch edge_count()") {
+	const auto graphs = random_graphs(12, 300, 4);
+	const auto counts = GraphBatch{ graphs }.edge_count();
+	REQUIRE(counts.size() == graphs.size());
+	for (size_t g = 0; g < graphs.size(); ++g) REQUIRE(counts[g] == graphs[g].edge_count());
+
+	GraphBatch batch(12, 3);
+	batch.set(1, Graph::fully_connected(12));
+	REQUIRE(batch.edge_count() == std::vector<int>{ 0, 66, 0 });
+}
@@ -0,0 +1,51 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "graph_code.h"
+#include "test_graphs.h"
+#include <random>
+#include <unordered_set>
+
+using namespace qe;
+
+
+TEST_CASE("GraphCode agrees with Graph::compress()") {
+	std::mt19937 rng{ 15 };
+	for (int n = 0; n <= 11; ++n) {
+		const auto graph = random_graph(n, rng, 0.4);
+		const GraphCode code{ graph };
+		REQUIRE(code.num_vertices() == n);
+		REQUIRE(code.words().size() == (n > 1 ? 1u : 0u));
+		if (n > 1) REQUIRE(code.words()[0] == Graph::compress(graph));
+		REQUIRE(code.to_graph() == graph);
+	}
+}
+
+TEST_CASE("GraphCode of large graphs") {
+	std::mt19937 rng{ 16 };
+	for (int n : { 12, 63, 64, 65, 130, 200 }) {
+		const auto graph = random_graph(n, rng, 0.4);
+		const GraphCode code{ graph };
+		REQUIRE(code.num_bits() == static_cast<size_t>(n * (n - 1) / 2));
+		REQUIRE(code.words().size() == (code.num_bits() + 63) / 64);
+		REQUIRE(code.to_graph() == graph);
+		for (int i = 0; i < n; ++i) {
+			for (int j = 0; j < n; ++j) REQUIRE(code.has_edge(i, j) == graph.has_edge(i, j));
+		}
+		const GraphCode copy{ n, std::vector<GraphCode::word_type>(code.words().begin(), code.words().end()) };
+		REQUIRE(copy == code);
+	}
+}
+
+TEST_CASE("GraphCode ordering and hashing") {
+	Graph a{ 20 };
+	Graph b{ 20 };
+	a.add_edge(0, 1);
+	b.add_edge(18, 19);
+	REQUIRE(GraphCode{ a } < GraphCode{ b });
+	REQUIRE(GraphCode{ Graph{ 19 } } < GraphCode{ a });
+	REQUIRE(GraphCode{ a } == GraphCode{ a });
+
+	const std::unordered_set<GraphCode> codes{ GraphCode{ a }, GraphCode{ b }, GraphCode{ a } };
+	REQUIRE(codes.size() == 2);
+	REQUIRE(std::hash<GraphCode>{}(GraphCode{ a }) != std::hash<GraphCode>{}(GraphCode{ b }));
+}
@@ -0,0 +1,75 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "graph_invariants.h"
+#include "canonical_labeling.h"
+#include "graph_batch.h"
+#include "thread_pool.h"
+#include "test_graphs.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+
+using namespace qe;
+
+
+TEST_CASE("triangle_counts()") {
+	REQUIRE(triangle_counts(Graph::fully_connected(4)) == std::vector<int>{ 3, 3, 3, 3 });
+	REQUIRE(triangle_counts(Graph::star(5)) == std::vector<int>{ 0, 0, 0, 0, 0 });
+
+	const Graph graph{ 5, { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 2, 3 }, { 3, 4 } } };
+	REQUIRE(triangle_counts(graph) == std::vector<int>{ 1, 1, 1, 0, 0 });
+
+	// Rows spanning several words.
+	auto large = Graph::fully_connected(70);
+	REQUIRE(triangle_counts(large)[69] == 69 * 68 / 2);
+}
+
+TEST_CASE("wl_hash() is an isomorphism invariant") {
+	std::mt19937_64 rng{ 5 };
+	for (int n : { 1, 5, 9, 70 }) {
+		for (int i = 0; i < 10; ++i) {
+			const auto graph = random_graph(n, rng);
+			std::vector<int> permutation(n);
+			std::iota(permutation.begin(), permutation.end(), 0);
+			std::shuffle(permutation.begin(), permutation.end(), rng);
+			REQUIRE(wl_hash(graph) == wl_hash(graph.graph_isomorphism(permutation)));
+		}
+	}
+}
+
+TEST_CASE("wl_hash() separates non-isomorphic graphs") {
+	// A 6-cycle and two triangles are both 2-regular and only differ in their triangles.
+	const Graph two_triangles{ 6, { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 3, 4 }, { 4, 5 }, { 3, 5 } } };
+	const Graph cycle{ 6, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 }, { 0, 5 } } };
+	REQUIRE(wl_hash(two_triangles) != wl_hash(cycle));
+	REQUIRE(wl_hash(Graph(5)) != wl_hash(Graph(6)));
+
+	// All 156 isomorphism classes of graphs with 6 vertices.
+	constexpr int n = 6;
+	std::map<uint64_t, uint64_t> hash_of_class;
+	for (uint64_t code = 0; code < (uint64_t{ 1 } << (n * (n - 1) / 2)); ++code) {
+		const auto graph = Graph::decompress(n, code);
+		const auto [it, inserted] = hash_of_class.emplace(canonical_code(graph), wl_hash(graph));
+		REQUIRE(it->second == wl_hash(graph));
+	}
+	REQUIRE(hash_of_class.size() == 156);
+	std::set<uint64_t> hashes;
+	for (const auto& [canonical, hash] : hash_of_class) hashes.insert(hash);
+	REQUIRE(hashes.size() == hash_of_class.size());
+}
+
+TEST_CASE("wl_hash() in bulk") {
+	std::mt19937_64 rng{ 2 };
+	std::vector<Graph> graphs;
+	for (int i = 0; i < 300; ++i) graphs.push_back(random_graph(8, rng));
+	std::vector<uint64_t> expected;
+	for (const auto& graph : graphs) expected.push_back(wl_hash(graph, 2));
+
+	REQUIRE(wl_hash(graphs, 2) == expected);
+	Q::ThreadPool pool{ 3 };
+	REQUIRE(wl_hash(graphs, 2, &pool) == expected);
+	REQUIRE(wl_hash(GraphBatch{ graphs }, 2, &pool) == expected);
+	REQUIRE(wl_hash(std::span<const Graph>{}).empty());
+}
@@ -0,0 +1,76 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "graph_io.h"
+#include "test_graphs.h"
+#include <random>
+#include <sstream>
+
+using namespace qe;
+
+
+TEST_CASE("graph6 examples") {
+	// Example from the nauty format description
+	const Graph graph{ 5, { { 0, 2 }, { 0, 4 }, { 1, 3 }, { 3, 4 } } };
+	REQUIRE(to_graph6(graph) == "DQc");
+	REQUIRE(from_graph6("DQc") == graph);
+
+	REQUIRE(to_graph6(Graph{ 0 }) == "?");
+	REQUIRE(to_graph6(Graph{ 1 }) == "@");
+	REQUIRE(to_graph6(Graph{ 63 }).substr(0, 4) == "~??~");
+	REQUIRE(from_graph6(to_graph6(Graph{ 63 })) == Graph{ 63 });
+
+	REQUIRE_THROWS_AS(from_graph6("DQ"), Graph_format_error);
+	REQUIRE_THROWS_AS(from_graph6("D Qc"), Graph_format_error);
+}
+
+TEST_CASE("sparse6 examples") {
+	// Example from the nauty format description
+	const Graph graph{ 7, { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 5, 6 } } };
+	REQUIRE(to_sparse6(graph) == ":Fa@x^");
+	REQUIRE(from_sparse6(":Fa@x^") == graph);
+
+	// Padding special case: n = 2^k and the last edge ends at n - 2
+	const Graph padded{ 4, { { 0, 1 }, { 1, 2 } } };
+	REQUIRE(from_sparse6(to_sparse6(padded)) == padded);
+	REQUIRE_THROWS_AS(from_sparse6("Fa@x^"), Graph_format_error);
+}
+
+TEST_CASE("graph6 and sparse6 round trip") {
+	std::mt19937 rng{ 6 };
+	for (int n : { 2, 3, 4, 8, 16, 17, 62, 63, 64, 100, 300 }) {
+		for (double density : { 0.05, 0.5 }) {
+			const auto graph = random_graph(n, rng, density);
+			REQUIRE(from_graph6(to_graph6(graph)) == graph);
+			REQUIRE(from_sparse6(to_sparse6(graph)) == graph);
+		}
+	}
+}
+
+TEST_CASE("GraphReader and GraphWriter") {
+	std::mt19937 rng{ 7 };
+	std::vector<Graph> graphs;
+	for (int n = 1; n < 30; ++n) graphs.push_back(random_graph(n % 7 + 2, rng, 0.3));
+
+	for (auto format : { GraphFormat::graph6, GraphFormat::sparse6 }) {
+		std::stringstream stream;
+		GraphWriter writer{ stream, format, true };
+		for (const auto& graph : graphs) writer.write(graph);
+
+		GraphReader reader{ stream };
+		Graph graph{ 0 };
+		size_t count{};
+		while (reader.read(graph)) {
+			REQUIRE(graph == graphs[count]);
+			++count;
+		}
+		REQUIRE(count == graphs.size());
+		REQUIRE_FALSE(reader.next().has_value());
+	}
+
+	std::stringstream mixed{ ">>graph6<<DQc\r\n\n:Fa@x^\nD?\n" };
+	GraphReader reader{ mixed };
+	REQUIRE(reader.next()->edge_count() == 4);
+	REQUIRE(reader.next()->num_vertices() == 7);
+	REQUIRE_THROWS_AS(reader.next(), Graph_format_error);
+	REQUIRE(reader.line_number() == 4);
+}
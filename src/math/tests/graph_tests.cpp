@@ -2,6 +2,7 @@
 #include "catch2/catch_approx.hpp"
 
 #include "graph.h"
+#include <random>
 
 
 using namespace qe;
@@ -66,6 +67,45 @@ TEST_CASE("Graph swap vertices") {
 	REQUIRE(graph.has_edge(1, 2));
 }
 
+TEST_CASE("Graph local_complementation()") {
+	auto graph = Graph::star(4, 0);
+	graph.local_complementation(0);
+	REQUIRE(graph == Graph::fully_connected(4));
+	graph.local_complementation(0);
+	REQUIRE(graph == Graph::star(4, 0));
+	graph.local_complementation(2);
+	REQUIRE(graph == Graph::star(4, 0));
+
+	auto linear = Graph::linear(4);
+	linear.local_complementation({ 1, 2 });
+	REQUIRE(linear == Graph(4, { { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } }));
+
+	const std::vector<int> sequence{ 1, 2 };
+	auto linear2 = Graph::linear(4);
+	linear2.local_complementation(sequence);
+	REQUIRE(linear2 == linear);
+
+	// Multi-word rows against the definition: toggle all edges between neighbours.
+	for (int n : { 70, 130 }) {
+		Graph graph(n);
+		for (int i = 0; i < n; ++i) {
+			for (int j = i + 1; j < n; ++j) {
+				if ((i * 7 + j * 3) % 5 < 2) graph.add_edge(i, j);
+			}
+		}
+		for (int vertex : { 0, n / 2, n - 1 }) {
+			auto expected = graph;
+			for (int a = 0; a < n; ++a) {
+				for (int b = a + 1; b < n; ++b) {
+					if (graph.has_edge(vertex, a) && graph.has_edge(vertex, b)) expected.toggle_edge(a, b);
+				}
+			}
+			graph.local_complementation(vertex);
+			REQUIRE(graph == expected);
+		}
+	}
+}
+
 TEST_CASE("Graph boolean operations") {
 	using EdgeList = std::vector<std::pair<int, int>>;
 	auto graph1 = Graph::star(4, 0);
@@ -142,4 +182,45 @@ TEST_CASE("generate_subgraphs()") {
 	REQUIRE(is_in_list(g2));
 	REQUIRE(is_in_list(g3));
 	REQUIRE(is_in_list(g4));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Connected component labels") {
+	Graph graph(8);
+	graph.add_path({ 5, 3, 2 });
+	graph.add_path({ 7, 0 });
+	std::vector<int> labels(8);
+	REQUIRE(graph.connected_components(labels) == 5);
+	REQUIRE(labels == std::vector<int>{ 0, 1, 2, 2, 3, 2, 4, 0 });
+	REQUIRE(graph.connected_components() == std::vector<std::vector<int>>{ { { 0, 7 }, { 1 }, { 2, 3, 5 }, { 4 }, { 6 } } });
+
+	// Components spanning several words of the adjacency rows
+	Graph large(150);
+	for (int v = 0; v + 3 < 150; ++v) large.add_edge(v, v + 3);
+	large.add_edge(1, 149);
+	labels.resize(150);
+	REQUIRE(large.connected_components(labels) == 2);
+	for (int v = 0; v < 150; ++v) REQUIRE(labels[v] == (v % 3 == 0 ? 0 : 1));
+	REQUIRE(large.connected_components(true)[0].size() == 50);
+}
+
+TEST_CASE("Pivot") {
+	std::mt19937 rng{ 22 };
+	std::bernoulli_distribution edge{ 0.4 };
+	for (int n : { 6, 20, 64, 100 }) {
+		Graph graph{ n };
+		for (int i = 0; i < n; ++i) {
+			for (int j = i + 1; j < n; ++j) {
+				if (edge(rng)) graph.add_edge(i, j);
+			}
+		}
+		for (const auto& [u, v] : graph.get_edges()) {
+			auto expected = graph;
+			expected.local_complementation({ u, v, u });
+			auto pivoted = graph;
+			pivoted.pivot(u, v);
+			REQUIRE(pivoted == expected);
+			pivoted.pivot(v, u);
+			REQUIRE(pivoted == graph);
+		}
+	}
+}
@@ -0,0 +1,162 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "lc_class_database.h"
+#include "canonical_labeling.h"
+#include "lc_orbit.h"
+#include "thread_pool.h"
+#include <bit>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace qe;
+
+
+// CTest runs each test case in its own process, possibly in parallel, so every process uses
+// its own file.
+static std::filesystem::path unique_temp_path(const std::string& name) {
+	return std::filesystem::temp_directory_path() / (name + std::to_string(std::random_device{}()) + ".bin");
+}
+
+/// Database for up to 6 vertices that is generated once per process and removed at exit.
+struct TestDatabase {
+	std::filesystem::path path{ unique_temp_path("qe_lc_class_database_test") };
+
+	TestDatabase() {
+		Q::ThreadPool pool{ 2 };
+		write_lc_class_database(path, 6, &pool);
+	}
+	~TestDatabase() { std::filesystem::remove(path); }
+};
+
+static const std::filesystem::path& database_path() {
+	static const TestDatabase database;
+	return database.path;
+}
+
+
+TEST_CASE("LcClassDatabase counts") {
+	const LcClassDatabase database{ database_path() };
+	REQUIRE(database.max_vertices() == 6);
+	// Non-isomorphic graphs with 1 to 6 vertices.
+	REQUIRE(database.num_graphs() == 1 + 2 + 4 + 11 + 34 + 156);
+
+	// Including disconnected graphs, whose classes are multisets of connected classes.
+	const size_t expected_classes[] = { 1, 2, 3, 6, 11, 26 };
+	size_t num_classes{};
+	for (int n = 1; n <= 6; ++n) {
+		std::set<uint32_t> ids;
+		uint32_t num_members{};
+		for (uint32_t id = 0; id < database.num_classes(); ++id) {
+			const auto info = database.class_info(id);
+			if (info.num_vertices != n) continue;
+			ids.insert(id);
+			num_members += info.num_members;
+		}
+		REQUIRE(ids.size() == expected_classes[n - 1]);
+		num_classes += expected_classes[n - 1];
+		const uint32_t num_graphs[] = { 1, 2, 4, 11, 34, 156 };
+		REQUIRE(num_members == num_graphs[n - 1]);
+	}
+	REQUIRE(database.num_classes() == num_classes);
+}
+
+TEST_CASE("LcClassDatabase lookup") {
+	const LcClassDatabase database{ database_path() };
+
+	const auto star = database.find(Graph::star(5));
+	const auto complete = database.find(Graph::fully_connected(5));
+	REQUIRE(star);
+	REQUIRE(complete);
+	REQUIRE(star->class_id == complete->class_id);
+	REQUIRE(star->orbit_size == lc_orbit(Graph::star(5)).size);
+	REQUIRE(star->representative_graph().edge_count() == 4);
+
+	REQUIRE_FALSE(database.find(Graph(7)));
+	REQUIRE_FALSE(database.find_canonical(5, ~uint64_t{}));
+
+	const auto empty = database.find(Graph(4));
+	REQUIRE(empty);
+	REQUIRE(empty->num_members == 1);
+	REQUIRE(empty->orbit_size == 1);
+	REQUIRE(empty->representative == 0);
+}
+
+TEST_CASE("LcClassDatabase agrees with lc_orbit() on all graphs with 5 vertices") {
+	const LcClassDatabase database{ database_path() };
+	constexpr int n = 5;
+	for (uint64_t code = 0; code < (uint64_t{ 1 } << (n * (n - 1) / 2)); ++code) {
+		const auto graph = Graph::decompress(n, code);
+		const auto info = database.find(graph);
+		REQUIRE(info);
+		REQUIRE(info->num_vertices == n);
+
+		const auto orbit = lc_orbit(graph);
+		REQUIRE(info->orbit_size == orbit.size);
+		int min_edges = n * n;
+		for (const auto member : orbit.members) {
+			min_edges = std::min(min_edges, std::popcount(member));
+			REQUIRE(database.find(Graph::decompress(n, member))->class_id == info->class_id);
+		}
+		REQUIRE(std::popcount(info->representative) == min_edges);
+		REQUIRE(canonical_code(info->representative_graph()) == info->representative);
+	}
+}
+
+TEST_CASE("LcClassDatabase rejects invalid files") {
+	const auto path = unique_temp_path("qe_lc_class_database_invalid");
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file << "not a database, but long enough for a header";
+	}
+	REQUIRE_THROWS_AS(LcClassDatabase{ path }, Database_format_error);
+
+	std::filesystem::resize_file(path, 4);
+	REQUIRE_THROWS_AS(LcClassDatabase{ path }, Database_format_error);
+
+	std::filesystem::copy_file(database_path(), path, std::filesystem::copy_options::overwrite_existing);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+	REQUIRE_THROWS_AS(LcClassDatabase{ path }, Database_format_error);
+
+	auto modify = [&](auto change) {
+		std::filesystem::copy_file(database_path(), path, std::filesystem::copy_options::overwrite_existing);
+		std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+		LcClassDatabase::Header header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		LcClassDatabase::GraphEntry first{};
+		file.read(reinterpret_cast<char*>(&first), sizeof(first));
+		change(header, first);
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(&first), sizeof(first));
+	};
+
+	// Counts whose table sizes overflow to the actual file size.
+	modify([](LcClassDatabase::Header& header, LcClassDatabase::GraphEntry&) {
+		header.num_graphs += uint64_t{ 1 } << 60;
+	});
+	REQUIRE_THROWS_AS(LcClassDatabase{ path }, Database_format_error);
+
+	modify([](LcClassDatabase::Header& header, LcClassDatabase::GraphEntry&) { ++header.num_classes; });
+	REQUIRE_THROWS_AS(LcClassDatabase{ path }, Database_format_error);
+
+	modify([](LcClassDatabase::Header&, LcClassDatabase::GraphEntry& first) { first.class_id = 1000; });
+	const LcClassDatabase corrupt{ path };
+	REQUIRE_THROWS_AS(corrupt.find(Graph(1)), Database_format_error);
+	REQUIRE(corrupt.find(Graph(2)));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("LcClassDatabase keeps its mapping when the file is regenerated") {
+	const auto path = unique_temp_path("qe_lc_class_database_regenerate");
+	write_lc_class_database(path, 3);
+	const LcClassDatabase database{ path };
+	write_lc_class_database(path, 4);
+
+	REQUIRE(database.max_vertices() == 3);
+	REQUIRE(database.num_graphs() == 1 + 2 + 4);
+	REQUIRE(database.find(Graph::star(3)));
+	REQUIRE(LcClassDatabase{ path }.max_vertices() == 4);
+	std::filesystem::remove(path);
+}
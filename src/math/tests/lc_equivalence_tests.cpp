@@ -0,0 +1,71 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "lc_equivalence.h"
+#include "test_graphs.h"
+#include <random>
+#include <set>
+
+using namespace qe;
+
+
+static void check_witness(const Graph& graph1, const Graph& graph2, const LcEquivalence& witness) {
+	auto graph = graph1;
+	graph.local_complementation(witness.sequence);
+	REQUIRE(graph == graph2);
+	REQUIRE(witness.local_cliffords.size() == static_cast<size_t>(graph1.num_vertices()));
+	for (const auto& q : witness.local_cliffords) {
+		REQUIRE((q.a * q.d + q.b * q.c) == 1);
+	}
+}
+
+
+TEST_CASE("lc_equivalence() of small graphs") {
+	const auto star = Graph::star(4);
+	const auto complete = Graph::fully_connected(4);
+	const auto witness = lc_equivalence(star, complete);
+	REQUIRE(witness.has_value());
+	check_witness(star, complete, *witness);
+
+	const auto identical = lc_equivalence(star, star);
+	REQUIRE(identical.has_value());
+	REQUIRE(identical->sequence.empty());
+	REQUIRE(identical->local_cliffords == std::vector<LocalClifford>(4));
+
+	Graph path{ 4 };
+	path.add_path({ 0, 1, 2, 3 });
+	REQUIRE_FALSE(is_lc_equivalent(path, star));
+	REQUIRE_FALSE(is_lc_equivalent(Graph(4), star));
+	REQUIRE_FALSE(is_lc_equivalent(Graph(3), star));
+}
+
+TEST_CASE("lc_equivalence() agrees with the LC orbit") {
+	std::vector<Graph> graphs{ Graph::star(5), Graph::cycle(5), Graph(5, { { 0, 1 }, { 1, 2 }, { 3, 4 } }) };
+	Graph path{ 5 };
+	path.add_path({ 0, 1, 2, 3, 4 });
+	graphs.push_back(path);
+
+	for (const auto& graph : graphs) {
+		const auto orbit = reference_orbit(graph);
+		for (uint64_t code = 0; code < (uint64_t{ 1 } << 10); ++code) {
+			const auto other = Graph::decompress(5, code);
+			const auto witness = lc_equivalence(graph, other);
+			REQUIRE(witness.has_value() == orbit.contains(code));
+			if (witness) check_witness(graph, other, *witness);
+		}
+	}
+}
+
+TEST_CASE("lc_equivalence() of random graphs") {
+	std::mt19937 rng{ 14 };
+	for (int n : { 8, 12, 20, 50, 70 }) {
+		const auto graph = random_graph(n, rng, 0.3);
+		auto other = graph;
+		std::uniform_int_distribution<int> vertex{ 0, n - 1 };
+		for (int i = 0; i < 4 * n; ++i) other.local_complementation(vertex(rng));
+
+		const auto witness = lc_equivalence(graph, other);
+		REQUIRE(witness.has_value());
+		check_witness(graph, other, *witness);
+		check_witness(other, graph, *lc_equivalence(other, graph));
+	}
+}
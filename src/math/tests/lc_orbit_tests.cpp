@@ -0,0 +1,67 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "lc_orbit.h"
+#include "thread_pool.h"
+#include "test_graphs.h"
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace qe;
+
+
+TEST_CASE("lc_orbit() of small graphs") {
+	const auto star = lc_orbit(Graph::star(4));
+	REQUIRE(star.complete);
+	REQUIRE(star.size == 5);
+	REQUIRE(star.members.size() == 5);
+	REQUIRE(std::count(star.members.begin(), star.members.end(), Graph::compress(Graph::fully_connected(4))) == 1);
+	REQUIRE(star.representative == *std::min_element(star.members.begin(), star.members.end()));
+
+	const auto empty = lc_orbit(Graph(3));
+	REQUIRE(empty.size == 1);
+	REQUIRE(empty.representative == 0);
+}
+
+TEST_CASE("lc_orbit() matches reference enumeration") {
+	Q::ThreadPool pool{ 3 };
+	for (auto graph : { Graph::linear(7), Graph::cycle(8), Graph::pusteblume(9) }) {
+		const auto expected = reference_orbit(graph);
+		for (auto* p : { static_cast<Q::ThreadPool*>(nullptr), &pool }) {
+			auto orbit = lc_orbit(graph, { .pool = p });
+			REQUIRE(orbit.complete);
+			REQUIRE(orbit.size == expected.size());
+			REQUIRE(orbit.representative == *expected.begin());
+			REQUIRE(std::set<uint64_t>(orbit.members.begin(), orbit.members.end()) == expected);
+		}
+		// All members of an orbit share the same representative.
+		const auto member = Graph::decompress(graph.num_vertices(), *expected.rbegin());
+		REQUIRE(lc_orbit(member, { .collect_members = false }).representative == *expected.begin());
+	}
+}
+
+TEST_CASE("lc_orbit() early termination") {
+	Q::ThreadPool pool{ 2 };
+	const auto target = Graph::fully_connected(5);
+	const auto orbit = lc_orbit(Graph::star(5, 2), {
+		.pool = &pool,
+		.stop_predicate = [&](const Graph& g) { return g == target; },
+	});
+	REQUIRE(!orbit.complete);
+	REQUIRE(orbit.match == Graph::compress(target));
+
+	const auto limited = lc_orbit(Graph::cycle(9), { .max_size = 50 });
+	REQUIRE(!limited.complete);
+	REQUIRE(limited.size >= 50);
+	REQUIRE(!limited.match);
+
+	// The limit equals the orbit size, so the orbit is still complete.
+	const auto full_size = lc_orbit(Graph::cycle(6)).size;
+	for (Q::ThreadPool* p : { static_cast<Q::ThreadPool*>(nullptr), &pool }) {
+		const auto exact = lc_orbit(Graph::cycle(6), { .pool = p, .max_size = full_size });
+		REQUIRE(exact.complete);
+		REQUIRE(exact.size == full_size);
+	}
+	REQUIRE(lc_orbit(Graph(4), { .max_size = 1 }).complete);
+	REQUIRE(!lc_orbit(Graph::star(4), { .max_size = 1 }).complete);
+}
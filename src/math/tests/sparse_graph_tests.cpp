@@ -0,0 +1,84 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "sparse_graph.h"
+#include <random>
+
+using namespace qe;
+
+
+TEST_CASE("SparseGraph conversion") {
+	Graph graph{ 70 };
+	graph.add_path({ 0, 5, 69, 3, 64 });
+	graph.add_edge(1, 2);
+	const SparseGraph sparse{ graph };
+	REQUIRE(sparse.num_vertices() == 70);
+	REQUIRE(sparse.edge_count() == 5);
+	REQUIRE(sparse.to_graph() == graph);
+	REQUIRE(sparse.get_edges() == graph.get_edges());
+	REQUIRE(std::vector<int>(sparse.neighbours(69).begin(), sparse.neighbours(69).end()) == std::vector<int>{ 3, 5 });
+	REQUIRE(sparse.has_edge(64, 3));
+	REQUIRE_FALSE(sparse.has_edge(64, 5));
+}
+
+TEST_CASE("SparseGraph edge operations") {
+	SparseGraph graph{ 5 };
+	graph.add_edge(0, 3);
+	graph.add_edge(3, 0);
+	graph.add_edge(2, 2);
+	REQUIRE(graph.edge_count() == 1);
+	graph.toggle_edge(1, 3);
+	REQUIRE(graph.degree(3) == 2);
+	graph.toggle_edge(3, 1);
+	graph.remove_edge(0, 4);
+	REQUIRE(graph.edge_count() == 1);
+	graph.remove_edge(3, 0);
+	REQUIRE(graph.edge_count() == 0);
+	REQUIRE(graph == SparseGraph{ 5 });
+}
+
+TEST_CASE("SparseGraph agrees with Graph") {
+	std::mt19937 rng{ 20 };
+	const int n = 40;
+	std::uniform_int_distribution<int> vertex{ 0, n - 1 };
+	Graph dense{ n };
+	SparseGraph sparse{ n };
+	for (int step = 0; step < 2000; ++step) {
+		const int u = vertex(rng);
+		const int v = vertex(rng);
+		if (step % 3 == 0) {
+			dense.local_complementation(u);
+			sparse.local_complementation(u);
+		}
+		else if (u != v) {
+			dense.toggle_edge(u, v);
+			sparse.toggle_edge(u, v);
+		}
+		REQUIRE(sparse.edge_count() == static_cast<size_t>(dense.edge_count()));
+	}
+	REQUIRE(sparse.to_graph() == dense);
+	REQUIRE(SparseGraph{ dense } == sparse);
+
+	auto components = dense.connected_components(true);
+	for (auto& component : components) std::sort(component.begin(), component.end());
+	REQUIRE(sparse.connected_components(true) == components);
+}
+
+TEST_CASE("SparseGraph of a large lattice") {
+	auto lattice = SparseGraph::grid(200, 200);
+	REQUIRE(lattice.num_vertices() == 40000);
+	REQUIRE(lattice.edge_count() == 2 * 200 * 199);
+	REQUIRE(lattice.connected_components().size() == 1);
+
+	// Local complementation at an inner vertex connects its four neighbours pairwise
+	const int center = 100 * 200 + 100;
+	lattice.local_complementation(center);
+	REQUIRE(lattice.edge_count() == 2 * 200 * 199 + 6);
+	REQUIRE(lattice.has_edge(center - 1, center + 1));
+	REQUIRE(lattice.has_edge(center - 200, center + 1));
+	lattice.local_complementation(center);
+	REQUIRE(lattice == SparseGraph::grid(200, 200));
+
+	lattice.remove_edge(0, 1);
+	lattice.remove_edge(0, 200);
+	REQUIRE(lattice.connected_components(true).front() == std::vector<int>{ 0 });
+}
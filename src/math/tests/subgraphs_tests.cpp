@@ -0,0 +1,191 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "subgraphs.h"
+#include <atomic>
+#include <bit>
+#include <ranges>
+#include <set>
+
+using namespace qe;
+
+static_assert(std::ranges::input_range<SubgraphRange>);
+
+
+TEST_CASE("SubgraphRange::binomial()") {
+	REQUIRE(SubgraphRange::binomial(5, 0) == 1);
+	REQUIRE(SubgraphRange::binomial(5, 2) == 10);
+	REQUIRE(SubgraphRange::binomial(5, 6) == 0);
+	REQUIRE(SubgraphRange::binomial(64, 32) == 1832624140942590534ULL);
+	REQUIRE(SubgraphRange::binomial(100, 50) == std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("subgraphs() visits every edge subset in the window once") {
+	const auto graph = Graph::fully_connected(5);
+	for (auto [min_edges, max_edges] : { std::pair{ 0, 10 }, std::pair{ 3, 5 }, std::pair{ 10, 10 }, std::pair{ -4, 1 }, std::pair{ 6, 4 } }) {
+		const auto range = subgraphs(graph, min_edges, max_edges);
+		std::set<uint64_t> codes;
+		int previous_edge_count{ -1 };
+		for (auto it = range.begin(); it != range.end(); ++it) {
+			REQUIRE(it->edge_count() == it.edge_count());
+			REQUIRE(it.edge_count() == std::popcount(it.mask()));
+			REQUIRE(it.edge_count() >= previous_edge_count);
+			REQUIRE(it.edge_count() >= min_edges);
+			REQUIRE(it.edge_count() <= max_edges);
+			REQUIRE(*it == range.subgraph(it.mask()));
+			REQUIRE(it.code() == Graph::compress(*it));
+			REQUIRE(codes.insert(it.code()).second);
+			previous_edge_count = it.edge_count();
+		}
+		REQUIRE(codes.size() == range.size());
+	}
+	REQUIRE(subgraphs(graph).size() == 1024);
+	REQUIRE(subgraphs(graph, 3, 5).size() == 120 + 210 + 252);
+}
+
+TEST_CASE("subgraphs() of graphs with many edges") {
+	// The largest supported number of edges
+	Graph graph{ 16 };
+	int count{};
+	for (int i = 0; i < 16 && count < 64; ++i) {
+		for (int j = i + 1; j < 16 && count < 64; ++j, ++count) graph.add_edge(i, j);
+	}
+	REQUIRE(graph.edge_count() == 64);
+
+	const auto range = subgraphs(graph, 63, 64);
+	REQUIRE(range.size() == 65);
+	uint64_t visited{};
+	for (auto it = range.begin(); it != range.end(); ++it) {
+		REQUIRE(it->edge_count() == it.edge_count());
+		++visited;
+	}
+	REQUIRE(visited == 65);
+
+	auto empty = subgraphs(graph, 0, 0).begin();
+	REQUIRE(empty->edge_count() == 0);
+	++empty;
+	REQUIRE(empty == std::default_sentinel);
+}
+
+TEST_CASE("generate_subgraphs() with an edge window") {
+	const auto graph = Graph::star(6);
+	REQUIRE(generate_subgraphs(graph).size() == 32);
+	REQUIRE(generate_subgraphs(graph, 2, 3).size() == 10 + 10);
+
+	// Ordered by edge mask like before the enumeration was based on SubgraphRange.
+	const auto range = subgraphs(graph, 1, 5);
+	const auto all = generate_subgraphs(graph, 1, 5);
+	for (size_t mask = 1; mask < 32; ++mask) REQUIRE(all[mask - 1] == range.subgraph(mask));
+}
+
+TEST_CASE("SubgraphRange::unrank_combination() follows the iteration order") {
+	const auto range = subgraphs(Graph::fully_connected(6), 0, 15);
+	std::vector<uint64_t> rank_of_size(16);
+	for (auto it = range.begin(); it != range.end(); ++it) {
+		const int k = it.edge_count();
+		REQUIRE(SubgraphRange::unrank_combination(k, rank_of_size[k]) == it.mask());
+		REQUIRE(range.at(k, rank_of_size[k]).mask() == it.mask());
+		++rank_of_size[k];
+	}
+	REQUIRE(SubgraphRange::unrank_combination(32, SubgraphRange::binomial(64, 32) - 1) == 0xFFFF'FFFF'0000'0000);
+}
+
+TEST_CASE("SubgraphRange::split()") {
+	const auto range = subgraphs(Graph::fully_connected(6), 2, 9);
+	const auto chunks = range.split(7, 100);
+	uint64_t total{};
+	for (const auto& chunk : chunks) {
+		REQUIRE(chunk.size > 0);
+		REQUIRE(chunk.rank + chunk.size <= SubgraphRange::binomial(15, chunk.edge_count));
+		total += chunk.size;
+	}
+	REQUIRE(total == range.size());
+}
+
+TEST_CASE("reduce_subgraphs() in parallel") {
+	struct Statistics {
+		uint64_t count{};
+		uint64_t edges{};
+		uint64_t connected{};
+	};
+	auto visit = [](Statistics& statistics, const Graph& subgraph, SubgraphRange::mask_type) {
+		++statistics.count;
+		statistics.edges += subgraph.edge_count();
+		statistics.connected += subgraph.connected_components().size() == 1;
+	};
+	auto combine = [](Statistics& result, const Statistics& chunk) {
+		result.count += chunk.count;
+		result.edges += chunk.edges;
+		result.connected += chunk.connected;
+	};
+
+	Graph graph = Graph::cycle(7);
+	graph.add_edge(0, 3);
+	graph.add_edge(2, 5);
+	graph.add_edge(1, 6);
+	graph.add_edge(4, 6);
+	const auto range = subgraphs(graph, 4, 9);
+
+	const auto sequential = reduce_subgraphs(range, Statistics{}, visit, combine);
+	REQUIRE(sequential.count == range.size());
+
+	Q::ThreadPool pool{ 4 };
+	const auto parallel = reduce_subgraphs(range, Statistics{}, visit, combine, &pool);
+	REQUIRE(parallel.count == sequential.count);
+	REQUIRE(parallel.edges == sequential.edges);
+	REQUIRE(parallel.connected == sequential.connected);
+
+	// A non-neutral initial value is only counted once.
+	auto count_visit = [](uint64_t& n, const Graph&, SubgraphRange::mask_type) { ++n; };
+	auto add = [](uint64_t& result, uint64_t chunk) { result += chunk; };
+	const auto counted = reduce_subgraphs(range, uint64_t{ 5 }, count_visit, add);
+	REQUIRE(counted == 5 + range.size());
+	REQUIRE(reduce_subgraphs(range, uint64_t{ 5 }, count_visit, add, &pool) == counted);
+
+	std::atomic<uint64_t> count{};
+	std::atomic<uint64_t> mask_sum{};
+	for_each_subgraph(range, [&](const Graph&, SubgraphRange::mask_type mask) { ++count; mask_sum += mask; }, &pool);
+	uint64_t expected_mask_sum{};
+	for (auto it = range.begin(); it != range.end(); ++it) expected_mask_sum += it.mask();
+	REQUIRE(count == range.size());
+	REQUIRE(mask_sum == expected_mask_sum);
+}
+
+TEST_CASE("SubgraphWalk maintains invariants along the Gray code") {
+	Graph graph = Graph::cycle(7);
+	graph.add_edge(0, 3);
+	graph.add_edge(2, 5);
+	graph.add_edge(1, 6);
+	graph.add_edge(4, 6);
+	graph.add_edge(0, 4);
+
+	SubgraphWalk walk{ graph };
+	REQUIRE(walk.component_count() == 7);
+	REQUIRE(walk.toggled_edge() == -1);
+	uint64_t steps{};
+	std::set<uint64_t> codes{ walk.code() };
+	while (walk.next()) {
+		++steps;
+		REQUIRE(walk.step() == steps);
+		REQUIRE(walk.mask() == (steps ^ (steps >> 1)));
+		REQUIRE(walk.toggled_edge() == std::countr_zero(steps));
+		REQUIRE(walk.graph() == subgraphs(graph).subgraph(walk.mask()));
+		REQUIRE(walk.edge_inserted() == walk.graph().has_edge(walk.edges()[walk.toggled_edge()].first, walk.edges()[walk.toggled_edge()].second));
+		REQUIRE(walk.edge_count() == walk.graph().edge_count());
+		REQUIRE(walk.code() == Graph::compress(walk.graph()));
+		REQUIRE(walk.component_count() == static_cast<int>(walk.graph().connected_components().size()));
+		for (int v = 0; v < 7; ++v) {
+			REQUIRE(walk.degrees()[v] == static_cast<int>(walk.graph().get_adjacency_matrix().row_count(v)));
+		}
+		codes.insert(walk.code());
+	}
+	REQUIRE(steps == (1u << 12) - 1);
+	REQUIRE(codes.size() == 1u << 12);
+	REQUIRE_FALSE(walk.next());
+	REQUIRE(walk.step() == steps);
+}
+
+TEST_CASE("SubgraphWalk of a graph without edges") {
+	SubgraphWalk walk{ Graph{ 3 } };
+	REQUIRE(walk.component_count() == 3);
+	REQUIRE_FALSE(walk.next());
+}
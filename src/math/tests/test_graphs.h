@@ -0,0 +1,38 @@
+#pragma once
+
+#include "graph.h"
+#include <random>
+#include <set>
+#include <vector>
+
+
+/// @brief Random graph in which each edge is present independently with the given probability.
+template<class Rng>
+qe::Graph random_graph(int num_vertices, Rng& rng, double density = 0.5) {
+	qe::Graph graph{ num_vertices };
+	std::bernoulli_distribution edge{ density };
+	for (int i = 0; i < num_vertices; ++i) {
+		for (int j = i + 1; j < num_vertices; ++j) {
+			if (edge(rng)) graph.add_edge(i, j);
+		}
+	}
+	return graph;
+}
+
+/// @brief Compressed codes of all graphs reachable by local complementations, found with a plain
+///    depth-first search as a reference for lc_orbit().
+inline std::set<uint64_t> reference_orbit(const qe::Graph& graph) {
+	const int n = graph.num_vertices();
+	std::set<uint64_t> orbit{ qe::Graph::compress(graph) };
+	std::vector<uint64_t> queue{ qe::Graph::compress(graph) };
+	while (!queue.empty()) {
+		const auto code = queue.back();
+		queue.pop_back();
+		for (int v = 0; v < n; ++v) {
+			auto g = qe::Graph::decompress(n, code);
+			g.local_complementation(v);
+			if (orbit.insert(qe::Graph::compress(g)).second) queue.push_back(qe::Graph::compress(g));
+		}
+	}
+	return orbit;
+}
@@ -0,0 +1,82 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "tracked_graph.h"
+#include <random>
+
+using namespace qe;
+
+
+static void require_consistent(const TrackedGraph& tracked) {
+	const auto& graph = tracked.graph();
+	REQUIRE(tracked.edge_count() == graph.edge_count());
+	for (int v = 0; v < graph.num_vertices(); ++v) {
+		REQUIRE(tracked.degree(v) == static_cast<int>(graph.adjacency_matrix.row_count(v)));
+	}
+	if (tracked.tracks_code()) REQUIRE(tracked.code() == Graph::compress(graph));
+}
+
+
+TEST_CASE("TrackedGraph edge operations") {
+	TrackedGraph graph{ Graph::star(5) };
+	require_consistent(graph);
+	REQUIRE(graph.degree(0) == 4);
+	REQUIRE(graph.edge_count() == 4);
+
+	graph.add_edge(1, 2);
+	graph.add_edge(2, 1);
+	graph.add_edge(3, 3);
+	REQUIRE(graph.edge_count() == 5);
+	require_consistent(graph);
+
+	graph.remove_edge(0, 4);
+	graph.remove_edge(0, 4);
+	REQUIRE(graph.degree(4) == 0);
+	require_consistent(graph);
+
+	graph.toggle_edge(4, 3);
+	graph.toggle_edge(1, 2);
+	REQUIRE(graph.edge_count() == 4);
+	require_consistent(graph);
+}
+
+TEST_CASE("TrackedGraph local complementation") {
+	TrackedGraph graph{ Graph::star(5) };
+	graph.local_complementation(0);
+	REQUIRE(graph.graph() == Graph::fully_connected(5));
+	REQUIRE(graph.edge_count() == 10);
+	require_consistent(graph);
+
+	graph.pivot(1, 2);
+	require_consistent(graph);
+}
+
+TEST_CASE("TrackedGraph random operations") {
+	std::mt19937_64 rng{ 9 };
+	for (int n : { 2, 7, 11, 12, 70 }) {
+		TrackedGraph graph{ n };
+		Graph reference{ n };
+		std::uniform_int_distribution<int> vertex{ 0, n - 1 };
+		for (int step = 0; step < 300; ++step) {
+			const int u = vertex(rng);
+			int v = vertex(rng);
+			if (u == v) v = (u + 1) % n;
+			switch (step % 4) {
+			case 0: graph.add_edge(u, v); reference.add_edge(u, v); break;
+			case 1: graph.toggle_edge(u, v); reference.toggle_edge(u, v); break;
+			case 2: graph.local_complementation(u); reference.local_complementation(u); break;
+			case 3:
+				if (graph.has_edge(u, v)) {
+					graph.pivot(u, v);
+					reference.pivot(u, v);
+				}
+				else {
+					graph.remove_edge(u, v);
+					reference.remove_edge(u, v);
+				}
+				break;
+			}
+			REQUIRE(graph.graph() == reference);
+			require_consistent(graph);
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vertex_minor.h"
+#include <random>
+#include <set>
+
+using namespace qe;
+
+
+/// All graphs on 4 target vertices reachable by local complementations and deletions.
+static std::set<uint64_t> reference_vertex_minors(const Graph& graph, const std::vector<int>& vertices) {
+	const int n = graph.num_vertices();
+	std::vector<bool> kept(n);
+	for (int v : vertices) kept[v] = true;
+
+	std::set<uint64_t> reached{ Graph::compress(graph) };
+	std::vector<uint64_t> queue{ Graph::compress(graph) };
+	std::set<uint64_t> minors;
+	while (!queue.empty()) {
+		const auto current = Graph::decompress(n, queue.back());
+		queue.pop_back();
+
+		bool all_deleted = true;
+		for (int v = 0; v < n; ++v) all_deleted &= kept[v] || current.get_adjacency_matrix().row_count(v) == 0;
+		if (all_deleted) {
+			Graph minor{ static_cast<int>(vertices.size()) };
+			for (size_t i = 0; i < vertices.size(); ++i) {
+				for (size_t j = i + 1; j < vertices.size(); ++j) {
+					if (current.has_edge(vertices[i], vertices[j])) minor.add_edge(static_cast<int>(i), static_cast<int>(j));
+				}
+			}
+			minors.insert(Graph::compress(minor));
+		}
+		for (int v = 0; v < n; ++v) {
+			auto next = current;
+			next.local_complementation(v);
+			if (reached.insert(Graph::compress(next)).second) queue.push_back(Graph::compress(next));
+			if (kept[v]) continue;
+			next = current;
+			next.remove_edges_to(v);
+			if (reached.insert(Graph::compress(next)).second) queue.push_back(Graph::compress(next));
+		}
+	}
+	return minors;
+}
+
+
+TEST_CASE("is_vertex_minor() of small graphs") {
+	const std::vector<int> ends{ 0, 4 };
+	Graph edge{ 2, { { 0, 1 } } };
+	REQUIRE(is_vertex_minor(Graph::linear(5), edge, ends));
+	REQUIRE_FALSE(is_vertex_minor(Graph{ 5 }, edge, ends));
+	REQUIRE(is_vertex_minor(Graph::linear(5), Graph{ 2 }, ends));
+
+	// Three leaves of a star can be connected as a path or a triangle, but the star cannot
+	// leave one of them isolated while the other two stay connected.
+	const std::vector<int> leaves{ 1, 2, 3 };
+	REQUIRE(is_vertex_minor(Graph::star(5), Graph::linear(3), leaves));
+	REQUIRE(is_vertex_minor(Graph::star(5), Graph::fully_connected(3), leaves));
+	REQUIRE_FALSE(is_vertex_minor(Graph::star(5), Graph{ 3, { { 0, 1 } } }, leaves));
+}
+
+TEST_CASE("is_vertex_minor() agrees with exhaustive search") {
+	std::mt19937 rng{ 22 };
+	std::bernoulli_distribution edge{ 0.45 };
+	const std::vector<int> vertices{ 0, 2, 3, 5 };
+	for (int trial = 0; trial < 6; ++trial) {
+		Graph graph{ 6 };
+		for (int i = 0; i < 6; ++i) {
+			for (int j = i + 1; j < 6; ++j) {
+				if (edge(rng)) graph.add_edge(i, j);
+			}
+		}
+		const auto minors = reference_vertex_minors(graph, vertices);
+		for (uint64_t code = 0; code < 64; ++code) {
+			REQUIRE(is_vertex_minor(graph, Graph::decompress(4, code), vertices) == minors.contains(code));
+		}
+	}
+}
@@ -0,0 +1,12 @@
+#include "tracked_graph.h"
+
+using namespace qe;
+
+
+qe::TrackedGraph::TrackedGraph(Graph graph) : graph_(std::move(graph)), degrees_(graph_.num_vertices()) {
+	for (int v = 0; v < num_vertices(); ++v) {
+		degrees_[v] = static_cast<int>(graph_.adjacency_matrix.row_count(v));
+	}
+	edge_count_ = graph_.edge_count();
+	if (tracks_code()) code_ = Graph::compress(graph_);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "graph.h"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace qe {
+
+	/// @brief Graph wrapper that keeps the vertex degrees, the number of edges and (for n <= 11)
+	///    the compressed code (see Graph::compress()) up to date while the graph is modified.
+	///
+	/// Edge operations update the statistics in O(1). A local complementation at v changes the
+	/// degree of each neighbour x by deg(v) - 1 - 2 |N(x) ∩ N(v)| and complements the pairs of
+	/// neighbours, which are contiguous runs of bits in the code. Thus it costs O(deg(v))
+	/// word operations in addition to the update of the adjacency matrix. Searches that query
+	/// edge_count() or code() after every step avoid rescanning the matrix.
+	///
+	/// The underlying graph is only accessible as const reference so that it cannot be
+	/// modified behind the wrapper's back.
+	class TrackedGraph {
+	public:
+		explicit TrackedGraph(int num_vertices) : TrackedGraph(Graph{ num_vertices }) {}
+
+		/// @brief Take over a graph and compute its statistics once.
+		explicit TrackedGraph(Graph graph);
+
+
+		const Graph& graph() const { return graph_; }
+		int num_vertices() const { return graph_.num_vertices(); }
+		bool has_edge(int vertex1, int vertex2) const { return graph_.has_edge(vertex1, vertex2); }
+
+		int degree(int vertex) const { return degrees_[vertex]; }
+		std::span<const int> degrees() const { return degrees_; }
+		int edge_count() const { return edge_count_; }
+
+		/// @brief Compressed code of the graph, equal to Graph::compress(graph()). Requires n <= 11.
+		uint64_t code() const {
+			assert(tracks_code() && "Compression is not supported for graphs of this size");
+			return code_;
+		}
+
+		/// @brief Whether the code is tracked, i.e. whether n <= 11.
+		bool tracks_code() const { return num_vertices() <= 11; }
+
+
+		void add_edge(int vertex1, int vertex2) {
+			if (vertex1 != vertex2 && !has_edge(vertex1, vertex2)) toggle_edge(vertex1, vertex2);
+		}
+
+		void remove_edge(int vertex1, int vertex2) {
+			if (has_edge(vertex1, vertex2)) toggle_edge(vertex1, vertex2);
+		}
+
+		void toggle_edge(int vertex1, int vertex2) {
+			assert(vertex1 != vertex2 && "Graphs cannot have self-loops");
+			const int change = has_edge(vertex1, vertex2) ? -1 : 1;
+			graph_.toggle_edge(vertex1, vertex2);
+			degrees_[vertex1] += change;
+			degrees_[vertex2] += change;
+			edge_count_ += change;
+			if (tracks_code()) code_ ^= uint64_t{ 1 } << bit_index(std::min(vertex1, vertex2), std::max(vertex1, vertex2));
+		}
+
+		/// @brief Complement the neighbourhood of the given vertex (see Graph::local_complementation()).
+		void local_complementation(int vertex) {
+			using word_type = Graph::AdjacencyMatrix::word_type;
+			constexpr auto word_bits = Graph::AdjacencyMatrix::word_bits;
+			const auto& a = graph_.adjacency_matrix;
+			const size_t num_words = a.words_per_row();
+			const word_type* neighbourhood = a.row(vertex).data();
+			const int d = degrees_[vertex];
+
+			// Each edge among the neighbours is counted from both endpoints.
+			int twice_inner_edges{};
+			for (size_t w = 0; w < num_words; ++w) {
+				for (word_type bits = neighbourhood[w]; bits; bits &= bits - 1) {
+					const size_t x = w * word_bits + std::countr_zero(bits);
+					const word_type* row = a.row(x).data();
+					int common{};
+					for (size_t k = 0; k < num_words; ++k) common += std::popcount(row[k] & neighbourhood[k]);
+					degrees_[x] += d - 1 - 2 * common;
+					twice_inner_edges += common;
+					// The pairs (x, y) with y > x in the neighbourhood are bits x + 1, ... of the
+					// neighbourhood, placed at the start of the code segment of x.
+					if (tracks_code()) code_ ^= (neighbourhood[0] >> (x + 1)) << bit_index(static_cast<int>(x), static_cast<int>(x) + 1);
+				}
+			}
+			edge_count_ += d * (d - 1) / 2 - twice_inner_edges;
+			graph_.local_complementation(vertex);
+		}
+
+		/// @brief Perform a series of local complementations in the given order.
+		void local_complementation(std::span<const int> vertices) {
+			for (int vertex : vertices) local_complementation(vertex);
+		}
+
+		/// @brief Pivot on the edge (u, v), i.e. the local complementations at u, v and u.
+		void pivot(int u, int v) {
+			assert(has_edge(u, v) && "Pivoting requires an edge between both vertices");
+			local_complementation(u);
+			local_complementation(v);
+			local_complementation(u);
+		}
+
+
+		friend bool operator==(const TrackedGraph& a, const TrackedGraph& b) { return a.graph_ == b.graph_; }
+
+	private:
+		Graph graph_;
+		std::vector<int> degrees_;
+		int edge_count_{};
+		uint64_t code_{};
+
+		/// Position of the edge (i, j) with i < j in the compressed code.
+		int bit_index(int i, int j) const {
+			const int n = num_vertices();
+			return i * (2 * n - i - 1) / 2 + (j - i - 1);
+		}
+	};
+
+}
@@ -0,0 +1,74 @@
+#include "vertex_minor.h"
+#include "graph_code.h"
+#include "lc_equivalence.h"
+#include <cassert>
+#include <unordered_set>
+
+using namespace qe;
+
+namespace {
+
+	class VertexMinorSearch {
+	public:
+		VertexMinorSearch(const Graph& target, std::span<const int> vertices, std::vector<int> deleted)
+			: target(target), vertices(vertices), deleted(std::move(deleted)), visited(this->deleted.size() + 1) {}
+
+		bool search(Graph& graph, size_t level) {
+			if (!visited[level].insert(GraphCode{ graph }).second) return false;
+			if (level == deleted.size()) return is_lc_equivalent(induced_subgraph(graph), target);
+
+			const int w = deleted[level];
+			const int u = static_cast<int>(graph.adjacency_matrix.row_find_first(w));
+			if (u == graph.num_vertices()) return search(graph, level + 1);
+
+			Graph branch = graph;
+			graph.remove_edges_to(w);
+			if (search(graph, level + 1)) return true;
+
+			graph = branch;
+			graph.local_complementation(w);
+			graph.remove_edges_to(w);
+			if (search(graph, level + 1)) return true;
+
+			branch.pivot(w, u);
+			branch.remove_edges_to(w);
+			return search(branch, level + 1);
+		}
+
+	private:
+		const Graph& target;
+		std::span<const int> vertices;
+		std::vector<int> deleted;
+		/// Codes of the graphs reached after deleting the first k vertices, for each k.
+		std::vector<std::unordered_set<GraphCode>> visited;
+
+		Graph induced_subgraph(const Graph& graph) const {
+			const int n = static_cast<int>(vertices.size());
+			Graph subgraph{ n };
+			for (int i = 0; i < n; ++i) {
+				for (int j = i + 1; j < n; ++j) {
+					if (graph.has_edge(vertices[i], vertices[j])) subgraph.add_edge(i, j);
+				}
+			}
+			return subgraph;
+		}
+	};
+
+}
+
+
+bool qe::is_vertex_minor(const Graph& graph, const Graph& target, std::span<const int> vertices) {
+	assert(static_cast<int>(vertices.size()) == target.num_vertices() && "Each target vertex needs a vertex of the graph");
+	std::vector<bool> kept(graph.num_vertices());
+	for (int v : vertices) {
+		assert(!kept[v] && "The vertices need to be distinct");
+		kept[v] = true;
+	}
+	std::vector<int> deleted;
+	for (int v = 0; v < graph.num_vertices(); ++v) {
+		if (!kept[v]) deleted.push_back(v);
+	}
+	VertexMinorSearch search{ target, vertices, std::move(deleted) };
+	Graph copy = graph;
+	return search.search(copy, 0);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "graph.h"
+#include <span>
+
+
+namespace qe {
+
+	/// @brief Check whether a graph can be turned into the target by local complementations and
+	///    vertex deletions, i.e. whether the target is a vertex-minor of the graph.
+	///
+	/// Vertices keep their labels: vertex i of the target is the vertex vertices[i] of the graph
+	/// and all other vertices are deleted. By a lemma of Bouchet, every vertex-minor of G on
+	/// V - {w} is locally equivalent to G - w, τ_w(G) - w or the pivot (G ∧ wu) - w for any fixed
+	/// neighbour u of w. Deleting one vertex after another therefore spans a tree with at most
+	/// three branches per deleted vertex, whose leaves are tested with lc_equivalence(). Graphs
+	/// that were already reached with the same deleted vertices are skipped using their
+	/// compressed codes, and branches that coincide are only explored once.
+	/// @param vertices Distinct vertices of the graph, one for each target vertex.
+	bool is_vertex_minor(const Graph& graph, const Graph& target, std::span<const int> vertices);
+
+}
@@ -0,0 +1,73 @@
+#include "concurrent_hash_set.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+using namespace Q;
+
+
+Q::ConcurrentHashSet::ConcurrentHashSet(size_t expected_size) {
+	const size_t capacity = capacity_for(expected_size);
+	slots = std::make_unique<std::atomic<key_type>[]>(capacity);
+	for (size_t i = 0; i < capacity; ++i) slots[i].store(empty_key, std::memory_order_relaxed);
+	mask = capacity - 1;
+}
+
+bool Q::ConcurrentHashSet::insert(key_type key) {
+	assert(key != empty_key && "The key ~0 is reserved");
+	assert(size() < capacity() && "ConcurrentHashSet is full, call reserve() beforehand");
+	for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+		key_type current = slots[i].load(std::memory_order_acquire);
+		if (current == empty_key) {
+			if (slots[i].compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+				count.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+			// Another thread claimed the slot in the meantime, current now holds its key.
+		}
+		if (current == key) return false;
+	}
+}
+
+bool Q::ConcurrentHashSet::contains(key_type key) const {
+	for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+		const key_type current = slots[i].load(std::memory_order_acquire);
+		if (current == key) return true;
+		if (current == empty_key) return false;
+	}
+}
+
+void Q::ConcurrentHashSet::reserve(size_t expected_size) {
+	if (capacity_for(expected_size) <= capacity()) return;
+	ConcurrentHashSet larger{ expected_size };
+	for (size_t i = 0; i <= mask; ++i) {
+		const key_type key = slots[i].load(std::memory_order_relaxed);
+		if (key != empty_key) larger.insert(key);
+	}
+	slots = std::move(larger.slots);
+	mask = larger.mask;
+}
+
+std::vector<ConcurrentHashSet::key_type> Q::ConcurrentHashSet::values() const {
+	std::vector<key_type> result;
+	result.reserve(size());
+	for (size_t i = 0; i <= mask; ++i) {
+		const key_type key = slots[i].load(std::memory_order_relaxed);
+		if (key != empty_key) result.push_back(key);
+	}
+	return result;
+}
+
+size_t Q::ConcurrentHashSet::hash(key_type key) {
+	// Finalizer of SplitMix64, which spreads structured keys (like graph codes) over all bits.
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111eb;
+	key ^= key >> 31;
+	return static_cast<size_t>(key);
+}
+
+size_t Q::ConcurrentHashSet::capacity_for(size_t expected_size) {
+	return std::bit_ceil(std::max<size_t>(2 * expected_size, 16));
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace Q {
+
+	/// @brief Insert-only hash set of 64-bit keys with lock-free concurrent insertion.
+	///
+	/// The keys are stored in a power-of-two sized array of atomics with linear probing. A slot
+	/// is claimed with a single compare-and-swap, so insert() and contains() can be called from
+	/// any number of threads. The table does not grow by itself: call reserve() (not thread-safe)
+	/// before a concurrent phase so that the load factor stays at most 1/2. The key ~0 is
+	/// reserved to mark empty slots.
+	class ConcurrentHashSet {
+	public:
+		using key_type = uint64_t;
+		static constexpr key_type empty_key = ~key_type{};
+
+		explicit ConcurrentHashSet(size_t expected_size = 0);
+
+		/// @brief Insert a key.
+		/// @return True if the key was not contained before.
+		bool insert(key_type key);
+
+		bool contains(key_type key) const;
+
+		size_t size() const { return count.load(std::memory_order_relaxed); }
+		size_t capacity() const { return mask + 1; }
+
+		/// @brief Make room for expected_size keys in total. Must not run concurrently with
+		///    other operations.
+		void reserve(size_t expected_size);
+
+		/// @brief All keys in unspecified order.
+		std::vector<key_type> values() const;
+
+	private:
+		std::unique_ptr<std::atomic<key_type>[]> slots;
+		size_t mask{};
+		std::atomic<size_t> count{};
+
+		static size_t hash(key_type key);
+		static size_t capacity_for(size_t expected_size);
+	};
+
+}
@@ -0,0 +1,96 @@
+#include "mapped_file.h"
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Q;
+
+namespace {
+
+	[[noreturn]] void throw_last_error(const char* what) {
+#ifdef _WIN32
+		throw std::system_error{ static_cast<int>(GetLastError()), std::system_category(), what };
+#else
+		throw std::system_error{ errno, std::system_category(), what };
+#endif
+	}
+
+}
+
+
+Q::MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+	const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) throw_last_error("Cannot open file for mapping");
+	LARGE_INTEGER file_size{};
+	if (!GetFileSizeEx(file, &file_size)) {
+		CloseHandle(file);
+		throw_last_error("Cannot determine file size");
+	}
+	size_ = static_cast<size_t>(file_size.QuadPart);
+	if (size_ != 0) {
+		const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			throw_last_error("Cannot map file");
+		}
+		data_ = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+	if (size_ != 0 && data_ == nullptr) throw_last_error("Cannot map file");
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) throw_last_error("Cannot open file for mapping");
+	struct stat status {};
+	if (::fstat(file, &status) != 0) {
+		::close(file);
+		throw_last_error("Cannot determine file size");
+	}
+	size_ = static_cast<size_t>(status.st_size);
+	if (size_ != 0) {
+		void* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0);
+		if (address == MAP_FAILED) {
+			::close(file);
+			throw_last_error("Cannot map file");
+		}
+		data_ = static_cast<const std::byte*>(address);
+	}
+	// The mapping stays valid after closing the descriptor.
+	::close(file);
+#endif
+}
+
+Q::MappedFile::~MappedFile() { unmap(); }
+
+Q::MappedFile::MappedFile(MappedFile&& other) noexcept
+	: data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& Q::MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		unmap();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+void Q::MappedFile::unmap() noexcept {
+	if (data_ == nullptr) return;
+#ifdef _WIN32
+	UnmapViewOfFile(data_);
+#else
+	::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
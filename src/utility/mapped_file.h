@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+
+namespace Q {
+
+	/// @brief Read-only memory mapping of a whole file.
+	///
+	/// The operating system loads pages on demand and shares them between all processes that
+	/// map the same file, so large lookup tables can be used without reading them into the heap.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+
+		/// @brief Map the file at the given path.
+		/// @throws std::system_error if the file cannot be opened or mapped.
+		explicit MappedFile(const std::filesystem::path& path);
+
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		const std::byte* data() const { return data_; }
+		size_t size() const { return size_; }
+		std::span<const std::byte> bytes() const { return { data_, size_ }; }
+
+	private:
+		const std::byte* data_{};
+		size_t size_{};
+
+		void unmap() noexcept;
+	};
+
+}
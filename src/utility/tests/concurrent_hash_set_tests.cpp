@@ -0,0 +1,46 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "concurrent_hash_set.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace Q;
+
+
+TEST_CASE("ConcurrentHashSet insert()") {
+	ConcurrentHashSet set;
+	REQUIRE(set.size() == 0);
+	REQUIRE(set.capacity() == 16);
+	REQUIRE(set.insert(0));
+	REQUIRE(set.insert(42));
+	REQUIRE(!set.insert(42));
+	REQUIRE(set.contains(0));
+	REQUIRE(set.contains(42));
+	REQUIRE(!set.contains(7));
+	REQUIRE(set.size() == 2);
+
+	set.reserve(1000);
+	REQUIRE(set.capacity() == 2048);
+	REQUIRE(set.contains(42));
+	for (uint64_t key = 0; key < 1000; ++key) set.insert(key * 64);
+	REQUIRE(set.size() == 1001);
+	auto values = set.values();
+	std::sort(values.begin(), values.end());
+	REQUIRE(values.size() == 1001);
+	REQUIRE(values[1] == 42);
+}
+
+TEST_CASE("ConcurrentHashSet concurrent insert()") {
+	ThreadPool pool{ 4 };
+	ConcurrentHashSet set{ 20000 };
+	std::atomic<size_t> inserted{};
+	// Every key is inserted by several chunks, but only one insertion succeeds.
+	pool.parallel_for(40000, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			if (set.insert((i * 7919) % 10000)) ++inserted;
+		}
+	});
+	REQUIRE(set.size() == 10000);
+	REQUIRE(inserted == 10000);
+}
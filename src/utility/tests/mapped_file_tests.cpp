@@ -0,0 +1,33 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "mapped_file.h"
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+
+using namespace Q;
+
+
+TEST_CASE("MappedFile") {
+	// Unique per process since CTest may run test processes in parallel.
+	const auto path = std::filesystem::temp_directory_path() / ("qe_mapped_file_test" + std::to_string(std::random_device{}()) + ".bin");
+	const std::string content = "memory mapped content";
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file << content;
+	}
+	MappedFile mapped{ path };
+	REQUIRE(mapped.size() == content.size());
+	REQUIRE(std::string(reinterpret_cast<const char*>(mapped.data()), mapped.size()) == content);
+
+	MappedFile moved{ std::move(mapped) };
+	REQUIRE(mapped.data() == nullptr);
+	REQUIRE(moved.bytes().size() == content.size());
+
+	moved = MappedFile{};
+	REQUIRE(moved.size() == 0);
+	std::filesystem::remove(path);
+
+	REQUIRE_THROWS_AS(MappedFile{ path }, std::system_error);
+}
@@ -0,0 +1,39 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "thread_pool.h"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+using namespace Q;
+
+
+TEST_CASE("ThreadPool submit()") {
+	ThreadPool pool{ 3 };
+	REQUIRE(pool.size() == 3);
+	auto a = pool.submit([] { return 6 * 7; });
+	auto b = pool.submit([] { throw std::runtime_error{ "failed" }; });
+	REQUIRE(a.get() == 42);
+	REQUIRE_THROWS_AS(b.get(), std::runtime_error);
+	REQUIRE(ThreadPool{ 0 }.size() == 1);
+}
+
+TEST_CASE("ThreadPool parallel_for()") {
+	ThreadPool pool{ 4 };
+	std::vector<int> values(1000);
+	std::atomic<size_t> calls{};
+	pool.parallel_for(values.size(), [&](size_t begin, size_t end) {
+		++calls;
+		for (size_t i = begin; i < end; ++i) values[i] += static_cast<int>(i);
+	});
+	std::vector<int> expected(1000);
+	std::iota(expected.begin(), expected.end(), 0);
+	REQUIRE(values == expected);
+	REQUIRE(calls <= 16);
+
+	calls = 0;
+	pool.parallel_for(10, [&](size_t, size_t) { ++calls; }, 5);
+	REQUIRE(calls == 2);
+	pool.parallel_for(0, [&](size_t, size_t) { ++calls; });
+	REQUIRE(calls == 2);
+}
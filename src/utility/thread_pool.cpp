@@ -0,0 +1,33 @@
+#include "thread_pool.h"
+
+using namespace Q;
+
+
+Q::ThreadPool::ThreadPool(size_t num_threads) {
+	num_threads = std::max<size_t>(num_threads, 1);
+	threads.reserve(num_threads);
+	for (size_t i = 0; i < num_threads; ++i) threads.emplace_back([this] { work(); });
+}
+
+Q::ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard lock{ mutex };
+		stopping = true;
+	}
+	condition.notify_all();
+	for (auto& thread : threads) thread.join();
+}
+
+void Q::ThreadPool::work() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock lock{ mutex };
+			condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) return;
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
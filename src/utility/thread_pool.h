@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Q {
+
+	/// @brief Fixed set of worker threads that execute submitted tasks in FIFO order.
+	class ThreadPool {
+	public:
+		/// @brief Start num_threads worker threads (at least one).
+		explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+
+		/// @brief Finish all queued tasks and join the workers.
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t size() const { return threads.size(); }
+
+		/// @brief Queue a task. Exceptions thrown by the task are rethrown by the returned future.
+		template<class F>
+		auto submit(F&& f) -> std::future<std::invoke_result_t<F>>;
+
+		/// @brief Call f(begin, end) on the workers for consecutive chunks covering [0, count)
+		///    and wait until all chunks are done. Must not be called from within a task of the
+		///    same pool.
+		/// @param min_chunk Smallest number of indices handed to a single call of f.
+		template<class F>
+		void parallel_for(size_t count, F&& f, size_t min_chunk = 1);
+
+	private:
+		std::vector<std::thread> threads;
+		std::deque<std::function<void()>> tasks;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool stopping{};
+
+		void work();
+	};
+
+
+	template<class F>
+	auto ThreadPool::submit(F&& f) -> std::future<std::invoke_result_t<F>> {
+		using Result = std::invoke_result_t<F>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+		auto future = task->get_future();
+		{
+			std::lock_guard lock{ mutex };
+			tasks.emplace_back([task] { (*task)(); });
+		}
+		condition.notify_one();
+		return future;
+	}
+
+	template<class F>
+	void ThreadPool::parallel_for(size_t count, F&& f, size_t min_chunk) {
+		if (count == 0) return;
+		// A few chunks per thread balance uneven work without much scheduling overhead.
+		const size_t num_chunks = std::max<size_t>(1, std::min(4 * size(), count / std::max<size_t>(min_chunk, 1)));
+		const size_t chunk_size = (count + num_chunks - 1) / num_chunks;
+		std::vector<std::future<void>> futures;
+		for (size_t begin = 0; begin < count; begin += chunk_size) {
+			const size_t end = std::min(begin + chunk_size, count);
+			futures.push_back(submit([&f, begin, end] { f(begin, end); }));
+		}
+		for (auto& future : futures) future.wait();
+		for (auto& future : futures) future.get();
+	}
+
+}